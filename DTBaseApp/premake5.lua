@@ -12,7 +12,8 @@ project "DTBaseApp"
 	{
 		"src/**.h",
 		"src/**.cpp",
-		"%{wks.location}/vendor/stb/**.h"
+		"%{wks.location}/vendor/stb/**.h",
+		"%{wks.location}/vendor/stb/stb_build.cpp"
 	}
 
 	includedirs
@@ -23,6 +24,11 @@ project "DTBaseApp"
 		"%{IncludeDir.stb}"
 	}
 
+	defines
+	{
+		"DT_ENABLE_PROFILING"
+	}
+
 	libdirs 
 	{
 	}
@@ -46,6 +52,25 @@ project "DTBaseApp"
 			"DT_ENABLE_LOGGING"
 		}
 
+	filter "system:linux"
+		defines
+		{
+			"DT_PLATFORM_LINUX",
+			"DT_ENABLE_LOGGING"
+		}
+
+		links
+		{
+			"pthread",
+			"dl"
+		}
+
+	filter "options:binary-logging"
+		defines "DT_ENABLE_BINARY_LOGGING"
+
+	filter "options:allocation-tracking"
+		defines "DT_ENABLE_ALLOCATION_TRACKING"
+
 	filter "configurations:Debug"
 		defines "DT_DEBUG"
 		runtime "Debug"
@@ -0,0 +1,227 @@
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace DT
+{
+	static constexpr uint32 s_TagSlotCount = 256u; // slot 0 collects untagged allocations and overflow
+
+	/* everything here is constant initialized: operator new can run before any static constructor */
+	struct TagSlot
+	{
+		std::atomic<const char*> Name = nullptr;
+		std::atomic<uint64> Allocations = 0u;
+		std::atomic<uint64> AllocatedBytes = 0u;
+		std::atomic<int64> LiveBytes = 0;
+	};
+
+	struct AllocationCounters
+	{
+		std::atomic<uint64> Allocations = 0u;
+		std::atomic<uint64> Frees = 0u;
+		std::atomic<uint64> AllocatedBytes = 0u;
+		std::atomic<int64> LiveBytes = 0;
+		std::atomic<int64> PeakLiveBytes = 0;
+		TagSlot Tags[s_TagSlotCount];
+	};
+
+	/* main thread only */
+	struct FrameAllocationCounters
+	{
+		uint64 WarmupFrames = 0u;
+		uint64 AllocationsAtFrameStart = 0u;
+		uint64 LastFrameAllocations = 0u;
+		uint64 MaxFrameAllocations = 0u;
+		uint64 MaxFrameAllocationsFrame = 0u;
+	};
+
+	static AllocationCounters s_Counters;
+	static FrameAllocationCounters s_FrameCounters;
+	static thread_local const char* s_ThreadTag = nullptr;
+	static thread_local uint32 s_ThreadTagSlot = 0u;
+
+	static uint32 FindTagSlot(const char* name)
+	{
+		if (name == nullptr)
+			return 0u;
+
+		uint32 start = uint32((uintptr_t(name) >> 3u) % (s_TagSlotCount - 1u));
+		for (uint32 probe = 0u; probe < s_TagSlotCount - 1u; probe++)
+		{
+			uint32 slot = 1u + (start + probe) % (s_TagSlotCount - 1u);
+			const char* expected = nullptr;
+			if (s_Counters.Tags[slot].Name.compare_exchange_strong(expected, name, std::memory_order_acq_rel) || expected == name)
+				return slot;
+		}
+		return 0u;
+	}
+
+	AllocationStatistics AllocationTracker::GetStatistics()
+	{
+		AllocationStatistics statistics;
+		statistics.Allocations = s_Counters.Allocations.load(std::memory_order_relaxed);
+		statistics.Frees = s_Counters.Frees.load(std::memory_order_relaxed);
+		statistics.AllocatedBytes = s_Counters.AllocatedBytes.load(std::memory_order_relaxed);
+		statistics.LiveAllocations = int64(statistics.Allocations - statistics.Frees);
+		statistics.LiveBytes = s_Counters.LiveBytes.load(std::memory_order_relaxed);
+		statistics.PeakLiveBytes = s_Counters.PeakLiveBytes.load(std::memory_order_relaxed);
+		statistics.LastFrameAllocations = s_FrameCounters.LastFrameAllocations;
+		statistics.MaxFrameAllocations = s_FrameCounters.MaxFrameAllocations;
+		statistics.MaxFrameAllocationsFrame = s_FrameCounters.MaxFrameAllocationsFrame;
+		return statistics;
+	}
+
+	std::vector<AllocationTagStatistics> AllocationTracker::GetTagStatistics()
+	{
+		std::vector<AllocationTagStatistics> tags;
+		for (uint32 slot = 0u; slot < s_TagSlotCount; slot++)
+		{
+			const TagSlot& tag = s_Counters.Tags[slot];
+			uint64 allocations = tag.Allocations.load(std::memory_order_relaxed);
+			if (allocations == 0u)
+				continue;
+
+			const char* name = tag.Name.load(std::memory_order_acquire);
+			tags.push_back({ name != nullptr ? name : "untagged", allocations, tag.AllocatedBytes.load(std::memory_order_relaxed), tag.LiveBytes.load(std::memory_order_relaxed) });
+		}
+
+		std::sort(tags.begin(), tags.end(), [](const AllocationTagStatistics& a, const AllocationTagStatistics& b)
+		{
+			return a.Allocations > b.Allocations;
+		});
+		return tags;
+	}
+
+	void AllocationTracker::SetWarmupFrames(uint64 warmupFrames)
+	{
+		s_FrameCounters.WarmupFrames = warmupFrames;
+	}
+
+	void AllocationTracker::EndFrame(uint64 frameIndex)
+	{
+		uint64 allocations = s_Counters.Allocations.load(std::memory_order_relaxed);
+		s_FrameCounters.LastFrameAllocations = allocations - s_FrameCounters.AllocationsAtFrameStart;
+		s_FrameCounters.AllocationsAtFrameStart = allocations;
+
+		if (frameIndex >= s_FrameCounters.WarmupFrames && s_FrameCounters.LastFrameAllocations > s_FrameCounters.MaxFrameAllocations)
+		{
+			s_FrameCounters.MaxFrameAllocations = s_FrameCounters.LastFrameAllocations;
+			s_FrameCounters.MaxFrameAllocationsFrame = frameIndex;
+		}
+	}
+
+	void AllocationTracker::Report()
+	{
+		if (!IsEnabled())
+			return;
+
+		AllocationStatistics statistics = GetStatistics();
+		LOG_INFO("Allocations: {} ({} bytes), frees: {}, peak live {} bytes", statistics.Allocations, statistics.AllocatedBytes, statistics.Frees, statistics.PeakLiveBytes);
+		LOG_INFO("Allocations per frame after {} warmup frames: max {} (frame {})", s_FrameCounters.WarmupFrames, statistics.MaxFrameAllocations, statistics.MaxFrameAllocationsFrame);
+		if (statistics.LiveAllocations > 0)
+			LOG_WARN("Still allocated: {} blocks, {} bytes (includes static objects destroyed after this report)", statistics.LiveAllocations, statistics.LiveBytes);
+
+		std::vector<AllocationTagStatistics> tags = GetTagStatistics();
+		for (size_t i = 0u; i < std::min<size_t>(tags.size(), 10u); i++)
+			LOG_INFO("   {:<32} {:>10} allocations {:>12} bytes {:>10} live", tags[i].Name, tags[i].Allocations, tags[i].AllocatedBytes, tags[i].LiveBytes);
+	}
+
+	const char* AllocationTracker::SetThreadTag(const char* name)
+	{
+		const char* previous = s_ThreadTag;
+	#if DT_ENABLE_ALLOCATION_TRACKING
+		if (name != previous)
+		{
+			s_ThreadTag = name;
+			s_ThreadTagSlot = FindTagSlot(name);
+		}
+	#endif
+		return previous;
+	}
+}
+
+#if DT_ENABLE_ALLOCATION_TRACKING
+
+namespace
+{
+	using namespace DT;
+
+	/* precedes every tracked block, keeps the user pointer 16 byte aligned */
+	struct alignas(16) AllocationHeader
+	{
+		uint64 Size;
+		uint32 TagSlot;
+		uint32 Offset; // from the start of the malloc block to the user pointer
+	};
+
+	void* TrackedAllocate(size_t size, size_t alignment, bool noThrow)
+	{
+		alignment = std::max(alignment, alignof(AllocationHeader));
+		size_t extra = sizeof(AllocationHeader) + (alignment > alignof(AllocationHeader) ? alignment : 0u);
+
+		std::byte* block = static_cast<std::byte*>(std::malloc(size + extra));
+		if (block == nullptr)
+		{
+			if (noThrow)
+				return nullptr;
+			throw std::bad_alloc();
+		}
+
+		uintptr_t user = (uintptr_t(block) + sizeof(AllocationHeader) + alignment - 1u) & ~uintptr_t(alignment - 1u);
+		AllocationHeader* header = reinterpret_cast<AllocationHeader*>(user) - 1;
+		header->Size = size;
+		header->TagSlot = s_ThreadTagSlot;
+		header->Offset = uint32(user - uintptr_t(block));
+
+		s_Counters.Allocations.fetch_add(1u, std::memory_order_relaxed);
+		s_Counters.AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		int64 live = s_Counters.LiveBytes.fetch_add(int64(size), std::memory_order_relaxed) + int64(size);
+		int64 peak = s_Counters.PeakLiveBytes.load(std::memory_order_relaxed);
+		while (live > peak && !s_Counters.PeakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+		TagSlot& tag = s_Counters.Tags[header->TagSlot];
+		tag.Allocations.fetch_add(1u, std::memory_order_relaxed);
+		tag.AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		tag.LiveBytes.fetch_add(int64(size), std::memory_order_relaxed);
+
+		return reinterpret_cast<void*>(user);
+	}
+
+	void TrackedFree(void* pointer)
+	{
+		if (pointer == nullptr)
+			return;
+
+		AllocationHeader* header = static_cast<AllocationHeader*>(pointer) - 1;
+		s_Counters.Frees.fetch_add(1u, std::memory_order_relaxed);
+		s_Counters.LiveBytes.fetch_sub(int64(header->Size), std::memory_order_relaxed);
+		s_Counters.Tags[header->TagSlot].LiveBytes.fetch_sub(int64(header->Size), std::memory_order_relaxed);
+
+		std::free(static_cast<std::byte*>(pointer) - header->Offset);
+	}
+}
+
+void* operator new  (size_t size)                                                             { return TrackedAllocate(size, 0u, false); }
+void* operator new[](size_t size)                                                             { return TrackedAllocate(size, 0u, false); }
+void* operator new  (size_t size, const std::nothrow_t&) noexcept                             { return TrackedAllocate(size, 0u, true); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept                             { return TrackedAllocate(size, 0u, true); }
+void* operator new  (size_t size, std::align_val_t alignment)                                 { return TrackedAllocate(size, size_t(alignment), false); }
+void* operator new[](size_t size, std::align_val_t alignment)                                 { return TrackedAllocate(size, size_t(alignment), false); }
+void* operator new  (size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, size_t(alignment), true); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, size_t(alignment), true); }
+
+void operator delete  (void* pointer) noexcept                                                { TrackedFree(pointer); }
+void operator delete[](void* pointer) noexcept                                                { TrackedFree(pointer); }
+void operator delete  (void* pointer, size_t) noexcept                                        { TrackedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept                                        { TrackedFree(pointer); }
+void operator delete  (void* pointer, const std::nothrow_t&) noexcept                         { TrackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept                         { TrackedFree(pointer); }
+void operator delete  (void* pointer, std::align_val_t) noexcept                              { TrackedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept                              { TrackedFree(pointer); }
+void operator delete  (void* pointer, size_t, std::align_val_t) noexcept                      { TrackedFree(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept                      { TrackedFree(pointer); }
+void operator delete  (void* pointer, std::align_val_t, const std::nothrow_t&) noexcept       { TrackedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept       { TrackedFree(pointer); }
+
+#endif
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+#include "Core.h"
+
+namespace DT
+{
+	struct AllocationStatistics
+	{
+		uint64 Allocations = 0u;
+		uint64 Frees = 0u;
+		uint64 AllocatedBytes = 0u;  // total since the start
+		int64 LiveAllocations = 0;
+		int64 LiveBytes = 0;
+		int64 PeakLiveBytes = 0;
+
+		uint64 LastFrameAllocations = 0u;
+		uint64 MaxFrameAllocations = 0u;     // over the frames after the warmup
+		uint64 MaxFrameAllocationsFrame = 0u;
+	};
+
+	/* allocations made inside an ALLOCATION_SCOPE (and every PROFILE_SCOPE) of the same name */
+	struct AllocationTagStatistics
+	{
+		const char* Name = nullptr;
+		uint64 Allocations = 0u;
+		uint64 AllocatedBytes = 0u;
+		int64 LiveBytes = 0;
+	};
+
+	/*
+		counts every global operator new/delete when built with DT_ENABLE_ALLOCATION_TRACKING,
+		without it the hooks are not compiled and every query returns zeros
+	*/
+	class AllocationTracker
+	{
+	public:
+		static constexpr bool IsEnabled()
+		{
+		#if DT_ENABLE_ALLOCATION_TRACKING
+			return true;
+		#else
+			return false;
+		#endif
+		}
+
+		static AllocationStatistics GetStatistics();
+		static std::vector<AllocationTagStatistics> GetTagStatistics();
+
+		/* frames before warmupFrames do not count towards MaxFrameAllocations */
+		static void SetWarmupFrames(uint64 warmupFrames);
+		/* main thread, once per frame: closes the allocation count of the frame */
+		static void EndFrame(uint64 frameIndex);
+
+		/* logs the totals, what is still alive and the busiest tags */
+		static void Report();
+
+		/* returns the previous tag of the calling thread, name must be a literal or interned string */
+		static const char* SetThreadTag(const char* name);
+	};
+
+	/* tags the allocations of the calling thread until the end of the scope */
+	class AllocationScope
+	{
+	public:
+		AllocationScope(const char* name)
+			: m_Previous(AllocationTracker::SetThreadTag(name)) {}
+		~AllocationScope() { AllocationTracker::SetThreadTag(m_Previous); }
+
+		AllocationScope(const AllocationScope&) = delete;
+		AllocationScope& operator = (const AllocationScope&) = delete;
+	private:
+		const char* m_Previous;
+	};
+
+#if DT_ENABLE_ALLOCATION_TRACKING
+	#define ALLOCATION_SCOPE_CONCAT_IMPL(a, b) a##b
+	#define ALLOCATION_SCOPE_CONCAT(a, b) ALLOCATION_SCOPE_CONCAT_IMPL(a, b)
+	#define ALLOCATION_SCOPE(name) ::DT::AllocationScope ALLOCATION_SCOPE_CONCAT(allocationScope, __LINE__)(name)
+#else
+	#define ALLOCATION_SCOPE(name)
+#endif
+}
\ No newline at end of file
@@ -1,15 +1,42 @@
 #include "Application.h"
+#include "EventDispatchTable.h"
+#include "FramePacer.h"
+#include "Profiler.h"
 #include "Layers/TestLayer.h"
 
 namespace DT
 {
 	Application::Application(const ApplicationSpecification& specification)
-		: m_Specification(specification)
+		: m_EventQueue(specification.EventQueueCapacity), m_Specification(specification)
 	{
 		s_Instance = this;
 
 		m_Window = Window::Create(m_Specification.WindowSpecification);
-		m_Window->SetEventCallBack(BIND_FUNC(OnEvent));
+		m_EventQueue.SetCoalescing(m_Specification.EventCoalescing);
+		m_Window->SetEventQueue(&m_EventQueue);
+		m_InputState.SetMousePosition(m_Window->GetMouseX(), m_Window->GetMouseY());
+
+		float frameBudget = m_Specification.FrameBudget;
+		if (frameBudget <= 0.0f)
+			frameBudget = m_Specification.FrameLoop.TargetFrameRate > 0.0f ? 1.0f / m_Specification.FrameLoop.TargetFrameRate : 1.0f / 60.0f;
+
+		m_FrameStatistics.Configure(m_Specification.Statistics);
+		m_StatisticSeries.Frame         = m_FrameStatistics.AddSeries("Frame", uint64(frameBudget * 1e9));
+		m_StatisticSeries.Events        = m_FrameStatistics.AddSeries("Events");
+		m_StatisticSeries.Update        = m_FrameStatistics.AddSeries("Update");
+		m_StatisticSeries.PrepareRender = m_FrameStatistics.AddSeries("PrepareRender");
+		m_StatisticSeries.Render        = m_FrameStatistics.AddSeries("Render");
+
+		/* from the platform callback to the end of the render of the frame that consumed the event */
+		m_StatisticSeries.InputLatencyMin = m_FrameStatistics.AddSeries("InputLatency.Min");
+		m_StatisticSeries.InputLatencyAvg = m_FrameStatistics.AddSeries("InputLatency.Avg");
+		m_StatisticSeries.InputLatencyMax = m_FrameStatistics.AddSeries("InputLatency.Max");
+
+		const EventRecordingSpecification& recording = m_Specification.EventRecording;
+		if (!recording.RecordPath.empty())
+			m_EventRecorder.Start(recording.RecordPath);
+		if (!recording.ReplayPath.empty() && m_EventReplayer.Open(recording.ReplayPath, recording.Mode))
+			LOG_TRACE("Replaying {} events from {}", m_EventReplayer.GetRecordCount(), recording.ReplayPath.string());
 
 		if (std::filesystem::exists(m_Specification.WorkingDirectory))
 			std::filesystem::current_path(m_Specification.WorkingDirectory);
@@ -28,47 +55,272 @@ namespace DT
 		}
 
 		delete m_Window;
+
+		LinearArena::Statistics arena = m_FramePacket.GetArena().GetStatistics();
+		for (const std::unique_ptr<FramePacket>& packet : m_FramePipeline.GetPackets())
+		{
+			LinearArena::Statistics packetArena = packet->GetArena().GetStatistics();
+			arena.HighWaterMark = std::max(arena.HighWaterMark, packetArena.HighWaterMark);
+			arena.OverflowCount += packetArena.OverflowCount;
+		}
+		if (arena.HighWaterMark > 0u)
+			LOG_TRACE("Frame arena high water mark {} bytes, {} block overflows", arena.HighWaterMark, arena.OverflowCount);
+
+		if (m_FrameIndex > 0u)
+		{
+			FrameStatisticsSummary frame = m_FrameStatistics.GetSummary(m_StatisticSeries.Frame);
+			LOG_INFO("Frame time p50 {:.3f}ms, p99 {:.3f}ms, max {:.3f}ms, {} frames over the {:.3f}ms budget",
+				frame.P50 * 1e-6, frame.P99 * 1e-6, frame.Max * 1e-6, frame.TotalOverruns, frame.Budget * 1e-6);
+
+			FrameStatisticsSummary latency = m_FrameStatistics.GetSummary(m_StatisticSeries.InputLatencyAvg);
+			FrameStatisticsSummary worst = m_FrameStatistics.GetSummary(m_StatisticSeries.InputLatencyMax);
+			if (latency.Count > 0u)
+				LOG_INFO("Input latency over {} frames: average p50 {:.3f}ms, p99 {:.3f}ms, worst event {:.3f}ms",
+					latency.Count, latency.P50 * 1e-6, latency.P99 * 1e-6, worst.Max * 1e-6);
+		}
+
+		const EventQueue::Statistics& stats = m_EventQueue.GetStatistics();
+		if (stats.Coalesced > 0u)
+			LOG_TRACE("Event queue coalesced {} events", stats.Coalesced);
+		if (stats.Dropped > 0u)
+			LOG_WARN("Event queue dropped {} of {} events (capacity {}, high water mark {})", stats.Dropped, stats.Pushed + stats.Dropped, m_EventQueue.GetCapacity(), stats.HighWaterMark);
 	}
 
 	void Application::PushLayer(Layer* layer)
 	{
+		#if DT_ENABLE_PROFILING
+			layer->m_ProfileZoneNames.OnUpdate = Profiler::InternString(layer->GetName() + "::OnUpdate");
+			layer->m_ProfileZoneNames.OnRender = Profiler::InternString(layer->GetName() + "::OnRender");
+			layer->m_ProfileZoneNames.OnEvent  = Profiler::InternString(layer->GetName() + "::OnEvent");
+		#endif
+
+		layer->m_StatisticSeries.OnUpdate = m_FrameStatistics.AddSeries(layer->GetName() + ".OnUpdate");
+		layer->m_StatisticSeries.OnRender = m_FrameStatistics.AddSeries(layer->GetName() + ".OnRender");
+
 		layer->OnAttach();
 		m_Layers.emplace_back(layer);
+
+		for (size_t type = 0u; type < m_EventSubscribers.size(); type++)
+		{
+			if (layer->IsInterestedIn(Event::Type(type)))
+				m_EventSubscribers[type].insert(m_EventSubscribers[type].begin(), layer);
+		}
+
+		m_ParallelUpdateGraph.Build(m_Layers, m_SerialUpdateLayers);
 	}
 
 	void Application::Run()
 	{
+		const FrameLoopSpecification& loop = m_Specification.FrameLoop;
+
+		if (loop.PipelinedRendering)
+			m_FramePipeline.Start(loop.FramesInFlight, BIND_FUNC(RenderPhase));
+
+		#if DT_ENABLE_PROFILING
+			const ProfilerSpecification& profiling = m_Specification.Profiling;
+			if (!profiling.CapturePath.empty())
+				Profiler::BeginCapture(profiling.CapturePath);
+		#endif
+
 		Timer timer;
+		FramePacer pacer(loop.TargetFrameRate);
+		/* a very high rate would round to 0 ns and never drain the accumulator */
+		const uint64 fixedTimestep = std::max<uint64>(Clock::FromSeconds(loop.FixedTimestep), 1u);
+		uint64 accumulator = 0u;
 		while (m_AppRunning)
 		{
-			m_Window->ProcessEvents();
-			UpdatePhase(timer.Mark());
-			RenderPhase();
+			PROFILE_SCOPE("Frame");
+
+			/* the packet and its arena are free once the render thread is done with their previous frame */
+			FramePacket& packet = m_FramePipeline.IsRunning() ? m_FramePipeline.AcquirePacket() : m_FramePacket;
+			packet.Reset();
+			m_FrameArena = &packet.GetArena();
+
+			m_InputState.BeginFrame();
+			m_InputTiming = {};
+
+			bool idle = loop.IdleWhenUnfocused && !m_WindowFocused;
+			{
+				PROFILE_SCOPE("ProcessEvents");
+				if (idle)
+					m_Window->WaitEvents(loop.IdleTimeout);
+				else
+					m_Window->ProcessEvents();
+			}
+			DispatchEvents();
+
+			uint64 frameTime = timer.MarkNanoseconds();
+			float dt = float(Clock::ToSeconds(frameTime));
+			if (m_FrameIndex > 0u)
+				m_FrameStatistics.Record(m_StatisticSeries.Frame, frameTime);
+			float alpha = 1.0f;
+			if (loop.Mode == LoopMode::FixedStep)
+			{
+				/* integer nanoseconds: the accumulator does not drift over long sessions */
+				accumulator += frameTime;
+
+				uint32 steps = 0u;
+				while (accumulator >= fixedTimestep && steps < loop.MaxStepsPerFrame)
+				{
+					UpdatePhase(loop.FixedTimestep);
+					accumulator -= fixedTimestep;
+					steps++;
+				}
+				accumulator %= fixedTimestep;
+				alpha = float(double(accumulator) / double(fixedTimestep));
+			}
+			else
+			{
+				UpdatePhase(dt);
+			}
+
+			PrepareRenderPhase(packet, dt, alpha);
+			if (m_FramePipeline.IsRunning())
+				m_FramePipeline.SubmitPacket();
+			else
+				RenderPhase(packet);
+			#if DT_ENABLE_ALLOCATION_TRACKING
+				AllocationTracker::EndFrame(m_FrameIndex);
+			#endif
+			m_FrameIndex++;
+			m_FrameStatistics.EndFrame();
+
+			#if DT_ENABLE_PROFILING
+				if (profiling.CaptureFrameCount == m_FrameIndex && Profiler::IsCapturing())
+					Profiler::EndCapture();
+			#endif
+
+			if (!idle)
+			{
+				PROFILE_SCOPE("FramePacing");
+				pacer.Wait();
+			}
+		}
+
+		m_FramePipeline.Stop();
+		m_FrameArena = &m_FramePacket.GetArena();
+
+		#if DT_ENABLE_PROFILING
+			if (Profiler::IsCapturing())
+				Profiler::EndCapture();
+		#endif
+	}
+
+	void Application::DispatchEvents()
+	{
+		PROFILE_FUNCTION();
+		FrameStatistics::Scope statistic(m_FrameStatistics, m_StatisticSeries.Events);
+
+		bool replaying = m_EventReplayer.IsOpen();
+		m_EventQueue.Drain([this, replaying](Event& event)
+		{
+			/*
+				the replay owns the event stream: live input would make the run non deterministic and
+				window events caused by replayed ones (a resize after a maximize) are in the log already
+			*/
+			if (replaying && event.GetType() != Event::Type::WindowClosed)
+				return;
+
+			if (m_EventRecorder.IsRecording())
+				m_EventRecorder.Record(m_FrameIndex, event);
+			OnEvent(event);
+		});
+
+		if (replaying)
+		{
+			m_EventReplayer.ReplayFrame(m_FrameIndex, [this](Event& event)
+			{
+				if (m_EventRecorder.IsRecording())
+					m_EventRecorder.Record(m_FrameIndex, event);
+				OnEvent(event);
+			});
+
+			if (m_EventReplayer.IsFinished())
+			{
+				LOG_TRACE("Event replay finished after {} frames", m_FrameIndex);
+				m_EventReplayer.Close();
+				if (m_Specification.EventRecording.CloseWhenReplayFinished)
+					m_AppRunning = false;
+			}
 		}
 	}
 
 	void Application::UpdatePhase(float dt)
 	{
-		for (Layer* layer : m_Layers)
+		PROFILE_FUNCTION();
+		FrameStatistics::Scope statistic(m_FrameStatistics, m_StatisticSeries.Update);
+
+		for (Layer* layer : m_SerialUpdateLayers)
+		{
+			PROFILE_SCOPE(layer->GetProfileZoneNames().OnUpdate);
+			FrameStatistics::Scope layerStatistic(m_FrameStatistics, layer->GetStatisticSeries().OnUpdate);
 			layer->OnUpdate(dt);
+		}
+
+		if (!m_ParallelUpdateGraph.IsEmpty())
+			m_ParallelUpdateGraph.Run(dt, m_FrameStatistics);
 	}
 
-	void Application::RenderPhase()
+	void Application::PrepareRenderPhase(FramePacket& packet, float dt, float alpha)
 	{
+		PROFILE_FUNCTION();
+		FrameStatistics::Scope statistic(m_FrameStatistics, m_StatisticSeries.PrepareRender);
+
+		packet.Begin(m_FrameIndex, dt, alpha, m_Layers);
+		packet.SetInputTiming(m_InputTiming);
 		for (Layer* layer : m_Layers)
-			layer->OnRender();
+			layer->OnPrepareRender(packet);
+	}
+
+	void Application::RenderPhase(const FramePacket& packet)
+	{
+		PROFILE_FUNCTION();
+		FrameStatistics::Scope statistic(m_FrameStatistics, m_StatisticSeries.Render);
+
+		for (Layer* layer : packet.GetLayers())
+		{
+			PROFILE_SCOPE(layer->GetProfileZoneNames().OnRender);
+			FrameStatistics::Scope layerStatistic(m_FrameStatistics, layer->GetStatisticSeries().OnRender);
+			layer->OnRender(packet);
+		}
+
+		const FramePacket::InputTiming& input = packet.GetInputTiming();
+		if (input.Count > 0u)
+		{
+			uint64 now = Clock::Now();
+			m_FrameStatistics.Record(m_StatisticSeries.InputLatencyMin, now - input.Newest);
+			m_FrameStatistics.Record(m_StatisticSeries.InputLatencyAvg, now - input.GetMean());
+			m_FrameStatistics.Record(m_StatisticSeries.InputLatencyMax, now - input.Oldest);
+		}
 	}
 
 	void Application::OnEvent(Event& event)
 	{
-		for (size_t i = m_Layers.size(); i > 0u; i--)
-			m_Layers[i - 1]->OnEvent(event);
+		m_InputState.OnEvent(event);
+		if (event.Timestamp != 0u && event.IsInCategory(Event::CategoryInput))
+			m_InputTiming.Add(event.Timestamp);
 
-		Event::Dispatcher dispatcher(event);
-		dispatcher.Dispatch<WindowClosedEvent>([&](WindowClosedEvent& e)
+		for (Layer* layer : m_EventSubscribers[size_t(event.GetType())])
 		{
-			m_AppRunning = false;
-			return false;
-		});
+			PROFILE_SCOPE(layer->m_ProfileZoneNames.OnEvent);
+			layer->m_DispatchCount++;
+			layer->OnEvent(event);
+			if (event.Handled)
+				break;
+		}
+
+		EventDispatchTable<&Application::OnWindowClosed, &Application::OnWindowFocus>::Dispatch(*this, event);
+	}
+
+	bool Application::OnWindowClosed(WindowClosedEvent& e)
+	{
+		m_AppRunning = false;
+		return false;
+	}
+
+	bool Application::OnWindowFocus(WindowFocusEvent& e)
+	{
+		m_WindowFocused = e.IsFocused();
+		return false;
 	}
 }
\ No newline at end of file
@@ -1,13 +1,57 @@
 #pragma once
 #include "Layer.h"
 #include "Window.h"
+#include "LayerUpdateGraph.h"
+#include "FramePipeline.h"
+#include "FrameStatistics.h"
+#include "EventRecorder.h"
+#include "InputState.h"
 
 namespace DT
 {
+	enum class LoopMode
+	{
+		Variable, // one update per frame with the measured dt
+		FixedStep // updates in FixedTimestep increments, rendering gets the interpolation alpha
+	};
+
+	struct FrameLoopSpecification
+	{
+		LoopMode Mode            = LoopMode::Variable;
+		float FixedTimestep      = 1.0f / 60.0f;
+		uint32 MaxStepsPerFrame  = 5u;    // catch-up cap, time beyond it is dropped
+		float TargetFrameRate    = 0.0f;  // 0 = unlimited
+		bool IdleWhenUnfocused   = false; // block on window events instead of spinning
+		float IdleTimeout        = 0.1f;  // seconds
+		bool PipelinedRendering  = false; // render on a dedicated thread, overlapped with the next update
+		uint32 FramesInFlight    = 1u;    // frames the render thread may lag behind the update
+	};
+
+	struct ProfilerSpecification
+	{
+		std::filesystem::path CapturePath; // empty = no capture, needs DT_ENABLE_PROFILING
+		uint64 CaptureFrameCount = 0u;     // 0 = until the application closes
+	};
+
+	struct EventRecordingSpecification
+	{
+		std::filesystem::path RecordPath; // log every dispatched event to this file
+		std::filesystem::path ReplayPath; // inject the events of this log, live events besides WindowClosed are ignored meanwhile
+		ReplayMode Mode = ReplayMode::RealTime;
+		bool CloseWhenReplayFinished = true;
+	};
+
 	struct ApplicationSpecification
 	{
-		WindowSpecification WindowSpecification;
+		DT::WindowSpecification WindowSpecification;
 		std::filesystem::path WorkingDirectory;
+		uint32 EventQueueCapacity = 1024u;
+		EventCoalescingSpecification EventCoalescing;
+		FrameLoopSpecification FrameLoop;
+		ProfilerSpecification Profiling;
+		FrameStatisticsSpecification Statistics;
+		EventRecordingSpecification EventRecording;
+		float FrameBudget = 0.0f; // seconds, overruns are counted against it, 0 = 1 / TargetFrameRate or 1 / 60
 	};
 
 	class Application
@@ -24,16 +68,57 @@ namespace DT
 		void OnEvent(Event& event);
 
 		Window& GetWindow() { return *m_Window; }
+		const InputState& GetInputState() const { return m_InputState; }
+		const std::vector<Layer*>& GetLayers() const { return m_Layers; }
+		const EventQueue& GetEventQueue() const { return m_EventQueue; }
+		uint64 GetFrameIndex() const { return m_FrameIndex; }
+		/* scratch memory reset at the top of every frame, with pipelined rendering it lives until the frame is rendered */
+		LinearArena& GetFrameArena() { return *m_FrameArena; }
+		FrameStatistics& GetFrameStatistics() { return m_FrameStatistics; }
+		const FrameStatistics& GetFrameStatistics() const { return m_FrameStatistics; }
 
 		static Application& Get() { return *s_Instance; }
 	private:
+		void DispatchEvents();
 		void UpdatePhase(float dt);
-		void RenderPhase();
+		void PrepareRenderPhase(FramePacket& packet, float dt, float alpha);
+		void RenderPhase(const FramePacket& packet);
+
+		bool OnWindowClosed(WindowClosedEvent& e);
+		bool OnWindowFocus(WindowFocusEvent& e);
 	private:
 		bool m_AppRunning = true;
+		bool m_WindowFocused = true;
+		uint64 m_FrameIndex = 0u;
 
 		Window* m_Window = nullptr;
+		EventQueue m_EventQueue;
+		InputState m_InputState;
 		std::vector<Layer*> m_Layers;
+		std::vector<Layer*> m_SerialUpdateLayers;
+		LayerUpdateGraph m_ParallelUpdateGraph;
+
+		FramePacket m_FramePacket;
+		FramePipeline m_FramePipeline;
+		LinearArena* m_FrameArena = &m_FramePacket.GetArena();
+
+		EventRecorder m_EventRecorder;
+		EventReplayer m_EventReplayer;
+
+		FrameStatistics m_FrameStatistics;
+		struct PhaseStatisticSeries
+		{
+			uint32 Frame = FrameStatistics::InvalidSeries;
+			uint32 Events = FrameStatistics::InvalidSeries;
+			uint32 Update = FrameStatistics::InvalidSeries;
+			uint32 PrepareRender = FrameStatistics::InvalidSeries;
+			uint32 Render = FrameStatistics::InvalidSeries;
+			uint32 InputLatencyMin = FrameStatistics::InvalidSeries;
+			uint32 InputLatencyAvg = FrameStatistics::InvalidSeries;
+			uint32 InputLatencyMax = FrameStatistics::InvalidSeries;
+		} m_StatisticSeries;
+		FramePacket::InputTiming m_InputTiming; // of the frame being built
+		std::array<std::vector<Layer*>, size_t(Event::Type::Count)> m_EventSubscribers; // topmost layer first
 
 		ApplicationSpecification m_Specification;
 		inline static Application* s_Instance = nullptr;
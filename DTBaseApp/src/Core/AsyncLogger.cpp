@@ -0,0 +1,224 @@
+#include "AsyncLogger.h"
+#include <bit>
+
+namespace DT
+{
+	AsyncLogger::AsyncLogger(std::string name, spdlog::sink_ptr sink, uint32 queueSize, LogOverflowPolicy overflowPolicy)
+		: spdlog::logger(std::move(name), std::move(sink)), m_OverflowPolicy(overflowPolicy)
+	{
+		uint64 capacity = std::bit_ceil(uint64(std::max(queueSize, 2u)));
+		m_Mask = capacity - 1u;
+		m_Slots = std::make_unique<Slot[]>(capacity);
+		for (uint64 i = 0u; i < capacity; i++)
+			m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+
+		m_Flusher = std::thread(&AsyncLogger::FlusherLoop, this);
+	}
+
+	AsyncLogger::~AsyncLogger()
+	{
+		Stop();
+	}
+
+	void AsyncLogger::Stop()
+	{
+		if (!m_Flusher.joinable())
+			return;
+
+		m_Stopping.store(true, std::memory_order_relaxed);
+		m_Wakeups.fetch_add(1u, std::memory_order_release);
+		m_Wakeups.notify_one();
+		m_Flusher.join();
+
+		/* whatever was published while the flusher exited */
+		m_Stopped.store(true, std::memory_order_release);
+		auto write = [this](Slot& slot)
+		{
+			spdlog::details::log_msg message = slot.Message;
+			message.payload = spdlog::string_view_t(slot.Payload.data(), slot.Payload.size());
+			Write(message, slot.Flush);
+		};
+		while (TryDequeue(write));
+		spdlog::logger::flush_();
+	}
+
+	void AsyncLogger::sink_it_(const spdlog::details::log_msg& message)
+	{
+		if (m_Stopped.load(std::memory_order_acquire))
+			spdlog::logger::sink_it_(message);
+		else
+			Enqueue(&message);
+	}
+
+	void AsyncLogger::flush_()
+	{
+		if (m_Stopped.load(std::memory_order_acquire))
+			spdlog::logger::flush_();
+		else
+			Enqueue(nullptr);
+	}
+
+	void AsyncLogger::Enqueue(const spdlog::details::log_msg* message)
+	{
+		while (!TryEnqueue(message))
+		{
+			/* the slot we need still holds the oldest message: retire it, unless the flusher already took it */
+			uint64 oldest = m_EnqueuePosition.load(std::memory_order_relaxed) - (m_Mask + 1u);
+			uint64 expected = oldest;
+			Slot& slot = m_Slots[oldest & m_Mask];
+			if (m_OverflowPolicy == LogOverflowPolicy::DropOldest &&
+				slot.Sequence.load(std::memory_order_acquire) == oldest + 1u &&
+				m_DequeuePosition.compare_exchange_strong(expected, oldest + 1u, std::memory_order_relaxed))
+			{
+				bool flush = slot.Flush;
+				slot.Sequence.store(oldest + m_Mask + 1u, std::memory_order_release);
+				if (!flush)
+					m_Dropped.fetch_add(1u, std::memory_order_relaxed);
+				continue;
+			}
+
+			WakeFlusher();
+			std::this_thread::yield();
+		}
+
+		/* pairs with the fence in FlusherLoop: either it sees the message or we see it going to sleep */
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_FlusherSleeping.load(std::memory_order_relaxed))
+			WakeFlusher();
+	}
+
+	bool AsyncLogger::TryEnqueue(const spdlog::details::log_msg* message)
+	{
+		uint64 position = m_EnqueuePosition.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			Slot& slot = m_Slots[position & m_Mask];
+			int64 difference = int64(slot.Sequence.load(std::memory_order_acquire) - position);
+			if (difference < 0)
+				return false;
+
+			if (difference > 0)
+			{
+				position = m_EnqueuePosition.load(std::memory_order_relaxed);
+				continue;
+			}
+
+			if (!m_EnqueuePosition.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+				continue;
+
+			slot.Flush = message == nullptr;
+			slot.Payload.clear();
+			if (message)
+			{
+				slot.Message = *message;
+				slot.Payload.append(message->payload.data(), message->payload.data() + message->payload.size());
+			}
+			slot.Sequence.store(position + 1u, std::memory_order_release);
+			return true;
+		}
+	}
+
+	/* fn sees the slot before it is handed back to the producers */
+	template<typename Fn>
+	bool AsyncLogger::TryDequeue(Fn&& fn)
+	{
+		uint64 position = m_DequeuePosition.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			Slot& slot = m_Slots[position & m_Mask];
+			int64 difference = int64(slot.Sequence.load(std::memory_order_acquire) - (position + 1u));
+			if (difference < 0)
+				return false;
+
+			if (difference > 0)
+			{
+				position = m_DequeuePosition.load(std::memory_order_relaxed);
+				continue;
+			}
+
+			if (!m_DequeuePosition.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+				continue;
+
+			fn(slot);
+			slot.Sequence.store(position + m_Mask + 1u, std::memory_order_release);
+			return true;
+		}
+	}
+
+	bool AsyncLogger::IsEmpty() const
+	{
+		uint64 position = m_DequeuePosition.load(std::memory_order_relaxed);
+		return m_Slots[position & m_Mask].Sequence.load(std::memory_order_acquire) != position + 1u;
+	}
+
+	void AsyncLogger::WakeFlusher()
+	{
+		m_FlusherSleeping.store(false, std::memory_order_relaxed);
+		m_Wakeups.fetch_add(1u, std::memory_order_release);
+		m_Wakeups.notify_one();
+	}
+
+	void AsyncLogger::FlusherLoop()
+	{
+		/* the slot is copied out and released before the sinks are written, so producers never wait on a sink */
+		spdlog::details::log_msg message;
+		spdlog::memory_buf_t payload;
+		bool flush = false;
+		auto copy = [&](Slot& slot)
+		{
+			flush = slot.Flush;
+			message = slot.Message;
+			payload.clear();
+			payload.append(slot.Payload.data(), slot.Payload.data() + slot.Payload.size());
+		};
+
+		for (;;)
+		{
+			if (TryDequeue(copy))
+			{
+				message.payload = spdlog::string_view_t(payload.data(), payload.size());
+				Write(message, flush);
+				continue;
+			}
+
+			if (m_Stopping.load(std::memory_order_relaxed))
+				break;
+
+			uint32 wakeups = m_Wakeups.load(std::memory_order_acquire);
+			m_FlusherSleeping.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (IsEmpty() && !m_Stopping.load(std::memory_order_relaxed))
+				m_Wakeups.wait(wakeups, std::memory_order_acquire);
+			m_FlusherSleeping.store(false, std::memory_order_relaxed);
+		}
+
+		for (spdlog::sink_ptr& sink : sinks_)
+			sink->flush();
+	}
+
+	void AsyncLogger::Write(const spdlog::details::log_msg& message, bool flush)
+	{
+		/* not spdlog::logger::sink_it_, whose flush_on check would enqueue from the flusher */
+		try
+		{
+			if (!flush)
+			{
+				for (spdlog::sink_ptr& sink : sinks_)
+				{
+					if (sink->should_log(message.level))
+						sink->log(message);
+				}
+			}
+
+			if (flush || should_flush_(message))
+			{
+				for (spdlog::sink_ptr& sink : sinks_)
+					sink->flush();
+			}
+		}
+		catch (const std::exception& exception)
+		{
+			err_handler_(exception.what());
+		}
+	}
+}
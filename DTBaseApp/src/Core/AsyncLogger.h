@@ -0,0 +1,59 @@
+#pragma once
+#include "Core.h"
+#include <atomic>
+#include <thread>
+
+namespace DT
+{
+	/*
+		spdlog logger whose sinks are written by a flusher thread. the caller formats the message into a preallocated
+		slot of a bounded lock-free ring (per slot sequence numbers, one CAS per message) and never takes a lock:
+		with Block it spins while the ring is full, with DropOldest it retires the oldest message itself.
+		the flusher sleeps on an atomic wait when the ring is empty and is only notified if it is asleep
+	*/
+	class AsyncLogger : public spdlog::logger
+	{
+	public:
+		AsyncLogger(std::string name, spdlog::sink_ptr sink, uint32 queueSize, LogOverflowPolicy overflowPolicy);
+		~AsyncLogger() override;
+
+		/* writes out what is queued and joins the flusher, later messages are written by the calling thread */
+		void Stop();
+
+		uint64 GetDroppedMessageCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+	protected:
+		void sink_it_(const spdlog::details::log_msg& message) override;
+		void flush_() override;
+	private:
+		struct Slot
+		{
+			std::atomic<uint64> Sequence = 0u;
+			spdlog::details::log_msg Message;
+			spdlog::memory_buf_t Payload; // grows once for a long message, then the slot keeps the capacity
+			bool Flush = false;
+		};
+
+		void Enqueue(const spdlog::details::log_msg* message);
+		bool TryEnqueue(const spdlog::details::log_msg* message);
+		template<typename Fn>
+		bool TryDequeue(Fn&& fn);
+		bool IsEmpty() const;
+
+		void WakeFlusher();
+		void FlusherLoop();
+		void Write(const spdlog::details::log_msg& message, bool flush);
+	private:
+		std::unique_ptr<Slot[]> m_Slots;
+		uint64 m_Mask = 0u;
+		LogOverflowPolicy m_OverflowPolicy;
+
+		alignas(64) std::atomic<uint64> m_EnqueuePosition = 0u;
+		alignas(64) std::atomic<uint64> m_DequeuePosition = 0u;
+		alignas(64) std::atomic<uint64> m_Dropped = 0u;
+		std::atomic<uint32> m_Wakeups = 0u;
+		std::atomic<bool> m_FlusherSleeping = false;
+		std::atomic<bool> m_Stopping = false;
+		std::atomic<bool> m_Stopped = false;
+		std::thread m_Flusher;
+	};
+}
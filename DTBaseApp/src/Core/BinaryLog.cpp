@@ -0,0 +1,210 @@
+#include "BinaryLog.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+
+namespace DT
+{
+	static constexpr uint32 s_ThreadBufferSize = 64u * 1024u;
+	static constexpr uint32 s_MaxPendingSize = 4u * 1024u * 1024u; // per thread, messages logged before Init
+	static constexpr uint32 s_MessageHeaderSize = 1u + sizeof(uint32) + sizeof(uint64) + sizeof(uint32) + sizeof(uint32);
+
+	struct RegisteredFormat
+	{
+		BinaryLogFormat::Level Level;
+		const char* Format;
+		const char* File;
+		uint32 Line;
+	};
+
+	struct BinaryLogState
+	{
+		std::mutex Mutex;
+		FILE* File = nullptr;
+		bool Initialized = false;
+		std::vector<RegisteredFormat> Formats;
+		std::atomic<uint32> NextThreadId = 0u;
+		std::atomic<uint64> DroppedPendingMessages = 0u;
+	};
+
+	static BinaryLogState s_State;
+
+	template<typename T>
+	static void WriteRaw(FILE* file, const T& value)
+	{
+		std::fwrite(&value, sizeof(T), 1u, file);
+	}
+
+	static void WriteString(FILE* file, const char* string)
+	{
+		uint16 length = (uint16)std::min<size_t>(std::strlen(string), UINT16_MAX);
+		WriteRaw(file, length);
+		std::fwrite(string, 1u, length, file);
+	}
+
+	/* expects s_State.Mutex to be locked */
+	static void WriteFormatRecord(FILE* file, uint32 id, const RegisteredFormat& format)
+	{
+		WriteRaw(file, BinaryLogFormat::RecordType::Format);
+		WriteRaw(file, id);
+		WriteRaw(file, format.Level);
+		WriteRaw(file, format.Line);
+		WriteString(file, format.File);
+		WriteString(file, format.Format);
+	}
+
+	/*
+		messages logged before Init stay buffered up to s_MaxPendingSize, they are written once the file exists;
+		after a failed Init or after Shutdown there is nowhere to write them and they are dropped
+	*/
+	class ThreadBuffer
+	{
+	public:
+		ThreadBuffer()
+			: m_ThreadId(s_State.NextThreadId.fetch_add(1u, std::memory_order_relaxed))
+		{
+			m_Data.resize(s_ThreadBufferSize);
+		}
+
+		~ThreadBuffer()
+		{
+			Flush();
+		}
+
+		uint32 GetThreadId() const { return m_ThreadId; }
+
+		std::byte* Allocate(uint32 size)
+		{
+			if (m_Used + size > m_Data.size())
+			{
+				Flush();
+				if (m_Used + size > m_Data.size())
+				{
+					/* still waiting for Init: the message is written to a scratch buffer and lost */
+					if (m_Used != 0u && m_Used + size > s_MaxPendingSize)
+					{
+						s_State.DroppedPendingMessages.fetch_add(1u, std::memory_order_relaxed);
+						m_Discard.resize(std::max<size_t>(m_Discard.size(), size));
+						return m_Discard.data();
+					}
+					m_Data.resize(m_Used + size);
+				}
+			}
+
+			std::byte* data = m_Data.data() + m_Used;
+			m_Used += size;
+			return data;
+		}
+
+		void Flush()
+		{
+			if (m_Used == 0u)
+				return;
+
+			std::scoped_lock lock(s_State.Mutex);
+			if (s_State.File == nullptr)
+			{
+				if (s_State.Initialized)
+					m_Used = 0u;
+				return;
+			}
+
+			std::fwrite(m_Data.data(), 1u, m_Used, s_State.File);
+			m_Used = 0u;
+		}
+	private:
+		std::vector<std::byte> m_Data;
+		std::vector<std::byte> m_Discard;
+		uint32 m_Used = 0u;
+		uint32 m_ThreadId;
+	};
+
+	static ThreadBuffer& GetThreadBuffer()
+	{
+		thread_local ThreadBuffer s_ThreadBuffer;
+		return s_ThreadBuffer;
+	}
+
+	void BinaryLog::Init(const std::filesystem::path& filePath)
+	{
+		std::scoped_lock lock(s_State.Mutex);
+
+		s_State.Initialized = true;
+		s_State.File = std::fopen(filePath.string().c_str(), "wb");
+		if (s_State.File == nullptr)
+		{
+			std::fprintf(stderr, "BinaryLog: failed to open '%s', binary log messages will be dropped\n", filePath.string().c_str());
+			return;
+		}
+
+		BinaryLogFormat::FileHeader header;
+		std::memcpy(header.Magic, BinaryLogFormat::Magic, sizeof(header.Magic));
+		header.Version = BinaryLogFormat::Version;
+		WriteRaw(s_State.File, header);
+
+		uint64 dropped = s_State.DroppedPendingMessages.load(std::memory_order_relaxed);
+		if (dropped != 0u)
+			std::fprintf(stderr, "BinaryLog: %llu messages logged before Init were dropped\n", (unsigned long long)dropped);
+
+		/* call sites that ran before Init */
+		for (uint32 id = 0u; id < (uint32)s_State.Formats.size(); id++)
+			WriteFormatRecord(s_State.File, id, s_State.Formats[id]);
+	}
+
+	void BinaryLog::Shutdown()
+	{
+		/* other threads flush when they exit, they are all joined by now */
+		Flush();
+
+		std::scoped_lock lock(s_State.Mutex);
+		if (s_State.File != nullptr)
+		{
+			std::fclose(s_State.File);
+			s_State.File = nullptr;
+		}
+	}
+
+	void BinaryLog::Flush()
+	{
+		GetThreadBuffer().Flush();
+
+		std::scoped_lock lock(s_State.Mutex);
+		if (s_State.File != nullptr)
+			std::fflush(s_State.File);
+	}
+
+	uint32 BinaryLog::RegisterFormat(BinaryLogFormat::Level level, const char* format, const char* file, uint32 line)
+	{
+		std::scoped_lock lock(s_State.Mutex);
+
+		uint32 id = (uint32)s_State.Formats.size();
+		s_State.Formats.push_back({ level, format, file, line });
+
+		if (s_State.File != nullptr)
+			WriteFormatRecord(s_State.File, id, s_State.Formats.back());
+		return id;
+	}
+
+	std::byte* BinaryLog::Reserve(uint32 formatId, uint32 payloadSize)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+		std::byte* record = buffer.Allocate(s_MessageHeaderSize + payloadSize);
+
+		uint64 timestamp = (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		uint32 threadId = buffer.GetThreadId();
+
+		std::byte* destination = record;
+		auto write = [&destination](const auto& value)
+		{
+			std::memcpy(destination, &value, sizeof(value));
+			destination += sizeof(value);
+		};
+		write(BinaryLogFormat::RecordType::Message);
+		write(formatId);
+		write(timestamp);
+		write(threadId);
+		write(payloadSize);
+		return destination;
+	}
+}
\ No newline at end of file
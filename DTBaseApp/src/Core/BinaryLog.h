@@ -0,0 +1,118 @@
+#pragma once
+#include "Core.h"
+#include "BinaryLogFormat.h"
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace DT
+{
+	/*
+		deferred formatting logger: a call site registers its format string once and every
+		message only copies the raw arguments into a per thread buffer, formatting happens
+		offline in Tools/LogDecoder
+	*/
+	class BinaryLog
+	{
+	public:
+		static void Init(const std::filesystem::path& filePath);
+		static void Shutdown();
+
+		/* writes the calling thread's buffered messages to the file */
+		static void Flush();
+
+		static uint32 RegisterFormat(BinaryLogFormat::Level level, const char* format, const char* file, uint32 line);
+
+		template<typename... Args>
+		static void Write(uint32 formatId, BinaryLogFormat::Level level, const Args&... args)
+		{
+			const uint32 payloadSize = (0u + ... + ArgumentSize(args));
+			std::byte* payload = Reserve(formatId, payloadSize);
+			(WriteArgument(payload, args), ...);
+
+			/* errors must reach the file even if the application goes down right after */
+			if (level >= BinaryLogFormat::Level::Error)
+				Flush();
+		}
+	private:
+		static std::byte* Reserve(uint32 formatId, uint32 payloadSize);
+
+		template<typename T>
+		static constexpr bool IsString = std::is_convertible_v<const T&, std::string_view>;
+
+		template<typename T>
+		static uint32 ArgumentSize(const T& argument)
+		{
+			if constexpr (IsString<T>)
+				return 1u + sizeof(uint32) + (uint32)std::string_view(argument).size();
+			else if constexpr (std::is_pointer_v<T>)
+				return 1u + sizeof(uint64);
+			else if constexpr (std::is_enum_v<T>)
+				return 1u + sizeof(std::underlying_type_t<T>);
+			else
+				return 1u + sizeof(T);
+		}
+
+		template<typename T>
+		static void WriteArgument(std::byte*& destination, const T& argument)
+		{
+			using namespace BinaryLogFormat;
+
+			if constexpr (IsString<T>)
+			{
+				std::string_view string(argument);
+				WriteValue(destination, ArgumentType::String, (uint32)string.size());
+				std::memcpy(destination, string.data(), string.size());
+				destination += string.size();
+			}
+			else if constexpr (std::is_pointer_v<T>)
+				WriteValue(destination, ArgumentType::Pointer, (uint64)reinterpret_cast<uintptr_t>(argument));
+			else if constexpr (std::is_enum_v<T>)
+				WriteArgument(destination, static_cast<std::underlying_type_t<T>>(argument));
+			else
+				WriteValue(destination, GetArgumentType<T>(), argument);
+		}
+
+		template<typename T>
+		static void WriteValue(std::byte*& destination, BinaryLogFormat::ArgumentType type, const T& value)
+		{
+			*destination++ = static_cast<std::byte>(type);
+			std::memcpy(destination, &value, sizeof(T));
+			destination += sizeof(T);
+		}
+
+		template<typename T>
+		static constexpr BinaryLogFormat::ArgumentType GetArgumentType()
+		{
+			using enum BinaryLogFormat::ArgumentType;
+
+			static_assert(std::is_arithmetic_v<T>, "BinaryLog only stores arithmetic types, enums, strings and pointers");
+
+			if constexpr (std::is_same_v<T, bool>)          return Bool;
+			else if constexpr (std::is_same_v<T, char>)     return Char;
+			else if constexpr (std::is_floating_point_v<T>) return sizeof(T) == 4u ? Float : Double;
+			else if constexpr (std::is_signed_v<T>)
+			{
+				if constexpr (sizeof(T) == 1u)      return Int8;
+				else if constexpr (sizeof(T) == 2u) return Int16;
+				else if constexpr (sizeof(T) == 4u) return Int32;
+				else                                return Int64;
+			}
+			else
+			{
+				if constexpr (sizeof(T) == 1u)      return UInt8;
+				else if constexpr (sizeof(T) == 2u) return UInt16;
+				else if constexpr (sizeof(T) == 4u) return UInt32;
+				else                                return UInt64;
+			}
+		}
+	};
+
+	/* the format id is resolved once per call site, format must be a string literal */
+	#define DT_BINARY_LOG(level, format, ...)                                                                              \
+		do                                                                                                                 \
+		{                                                                                                                  \
+			static const uint32 s_FormatId = ::DT::BinaryLog::RegisterFormat(level, format, __FILE__, __LINE__);         \
+			::DT::BinaryLog::Write(s_FormatId, level, ##__VA_ARGS__);                                                      \
+		} while (false)
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+
+/*
+	layout of the files written by DT::BinaryLog, shared with Tools/LogDecoder (all values little endian)
+
+	file    : FileHeader, then records in the order they were flushed
+	format  : RecordType::Format  | uint32 id | uint8 level | uint32 line | uint16 length + file | uint16 length + format
+	message : RecordType::Message | uint32 formatId | uint64 unix time ns | uint32 thread | uint32 payload size | payload
+
+	the payload is one ArgumentType tag per argument followed by its value,
+	strings are stored as uint32 length + bytes
+*/
+namespace DT::BinaryLogFormat
+{
+	inline constexpr char Magic[8] = { 'D', 'T', 'B', 'I', 'N', 'L', 'O', 'G' };
+	inline constexpr uint32_t Version = 1u;
+
+	struct FileHeader
+	{
+		char Magic[8];
+		uint32_t Version;
+	};
+
+	enum class RecordType : uint8_t
+	{
+		Format  = 1,
+		Message = 2
+	};
+
+	/* same order as spdlog::level::level_enum */
+	enum class Level : uint8_t
+	{
+		Trace, Debug, Info, Warn, Error, Critical
+	};
+
+	enum class ArgumentType : uint8_t
+	{
+		Bool, Char,
+		Int8, Int16, Int32, Int64,
+		UInt8, UInt16, UInt32, UInt64,
+		Float, Double,
+		String, Pointer
+	};
+}
\ No newline at end of file
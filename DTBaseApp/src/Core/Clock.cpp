@@ -0,0 +1,74 @@
+#include "Core.h"
+#include <thread>
+
+#if DT_CLOCK_TSC && !defined(_MSC_VER)
+	#include <cpuid.h>
+#endif
+
+namespace DT
+{
+	/* the TSC only measures time if it ticks at a constant rate through P and C states */
+	static bool HasInvariantTsc()
+	{
+	#if DT_CLOCK_TSC
+		uint32 registers[4] = {};
+		#if defined(_MSC_VER)
+			__cpuid((int*)registers, 0x80000000);
+			if (registers[0] < 0x80000007u)
+				return false;
+			__cpuid((int*)registers, 0x80000007);
+		#else
+			if (__get_cpuid_max(0x80000000u, nullptr) < 0x80000007u)
+				return false;
+			__cpuid(0x80000007u, registers[0], registers[1], registers[2], registers[3]);
+		#endif
+		return (registers[3] & Bit(8u)) != 0u;
+	#else
+		return false;
+	#endif
+	}
+
+	void Clock::Init(ClockSource source)
+	{
+		s_UsingTsc = false;
+		s_TscFrequency = 0u;
+		if (source != ClockSource::Tsc || !HasInvariantTsc())
+			return;
+
+	#if DT_CLOCK_TSC
+		/* bracket the samples tightly so a preemption between the two reads does not skew them */
+		auto sample = [](uint64& ticks, uint64& nanoseconds)
+		{
+			uint64 bestWindow = ~0ull;
+			for (uint32 i = 0u; i < 8u; i++)
+			{
+				uint64 before = __rdtsc();
+				uint64 now = SteadyNow();
+				uint64 after = __rdtsc();
+				if (after - before < bestWindow)
+				{
+					bestWindow = after - before;
+					ticks = before + (after - before) / 2u;
+					nanoseconds = now;
+				}
+			}
+		};
+
+		uint64 startTicks = 0u, startNanoseconds = 0u, endTicks = 0u, endNanoseconds = 0u;
+		sample(startTicks, startNanoseconds);
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		sample(endTicks, endNanoseconds);
+
+		double elapsedSeconds = ToSeconds(endNanoseconds - startNanoseconds);
+		if (endTicks <= startTicks || elapsedSeconds <= 0.0)
+			return;
+
+		double ticksPerSecond = double(endTicks - startTicks) / elapsedSeconds;
+		s_TscFrequency = uint64(ticksPerSecond);
+		s_NanosecondsPerTick = uint64(1e9 / ticksPerSecond * 4294967296.0);
+		s_BaseTicks = endTicks;
+		s_BaseNanoseconds = endNanoseconds;
+		s_UsingTsc = true;
+	#endif
+	}
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include "Core.h"
+#include <chrono>
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define DT_CLOCK_TSC 1
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+#endif
+
+namespace DT
+{
+	enum class ClockSource
+	{
+		Tsc,   // calibrated time stamp counter, falls back to Steady without an invariant TSC
+		Steady // std::chrono::steady_clock
+	};
+
+	/*
+		monotonic nanosecond clock: with the TSC source a read is one rdtsc and a 64x64 multiply,
+		Init() calibrates it against steady_clock (~20ms) and must run before any other thread reads it
+	*/
+	class Clock
+	{
+	public:
+		static void Init(ClockSource source = ClockSource::Tsc);
+
+		static uint64 Now()
+		{
+		#if DT_CLOCK_TSC
+			if (s_UsingTsc)
+			{
+				/* another core's TSC can read slightly behind the calibration core: clamp instead of wrapping to ~2^64 */
+				uint64 ticks = __rdtsc();
+				uint64 elapsed = ticks > s_BaseTicks ? ticks - s_BaseTicks : 0u;
+				return s_BaseNanoseconds + MultiplyShift32(elapsed, s_NanosecondsPerTick);
+			}
+		#endif
+			return SteadyNow();
+		}
+
+		static ClockSource GetSource() { return s_UsingTsc ? ClockSource::Tsc : ClockSource::Steady; }
+		static uint64 GetTscFrequency() { return s_TscFrequency; } // ticks per second, 0 without the TSC source
+
+		static constexpr double ToSeconds(uint64 nanoseconds) { return double(nanoseconds) * 1e-9; }
+		static constexpr uint64 FromSeconds(double seconds) { return uint64(seconds * 1e9 + 0.5); }
+	private:
+		static uint64 SteadyNow()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		/* (value * factor) >> 32 without overflowing */
+		static uint64 MultiplyShift32(uint64 value, uint64 factor)
+		{
+		#if defined(_MSC_VER)
+			uint64 high;
+			uint64 low = _umul128(value, factor, &high);
+			return __shiftright128(low, high, 32);
+		#else
+			return uint64((unsigned __int128)value * factor >> 32u);
+		#endif
+		}
+	private:
+		inline static bool s_UsingTsc = false;
+		inline static uint64 s_BaseTicks = 0u;
+		inline static uint64 s_BaseNanoseconds = 0u;
+		inline static uint64 s_NanosecondsPerTick = 0u; // 32.32 fixed point
+		inline static uint64 s_TscFrequency = 0u;
+	};
+}
\ No newline at end of file
@@ -1,18 +1,47 @@
 #include "Core.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "AllocationTracker.h"
+#include "Image/ImageLoader.h"
 
 namespace DT
 {
-	void InitializeCore()
+	void InitializeCore(const CoreSpecification& specification)
 	{
+		Clock::Init(specification.Clock);
+
 		#if DT_ENABLE_LOGGING
-			Log::Init();
+			#if DT_ENABLE_BINARY_LOGGING
+				BinaryLog::Init(specification.Logging.BinaryLogPath);
+			#endif
+			Log::Init(specification.Logging);
 		#endif
+
+		Profiler::Init();
+		JobSystem::Init(specification.WorkerThreadCount);
+		ImageLoader::Init({ specification.ImageCacheBudget, specification.ImageDiskCache });
+
+		if (Clock::GetSource() == ClockSource::Tsc)
+			LOG_TRACE("Clock source: TSC at {:.3f} GHz", Clock::GetTscFrequency() * 1e-9);
 	}
 	
 	void ShutdownCore()
 	{
+		ImageLoader::Shutdown();
+		JobSystem::Shutdown();
+		Profiler::Shutdown();
+
+		#if DT_ENABLE_ALLOCATION_TRACKING
+			AllocationTracker::Report();
+		#endif
+
 		#if DT_ENABLE_LOGGING
+			if (uint64 dropped = Log::GetDroppedMessageCount(); dropped > 0u)
+				LOG_WARN("Asynchronous logger dropped {} messages", dropped);
 			Log::Shutdown();
+			#if DT_ENABLE_BINARY_LOGGING
+				BinaryLog::Shutdown();
+			#endif
 		#endif
 	}
 }
\ No newline at end of file
@@ -2,10 +2,14 @@
 
 #include <cstdint>
 #include <vector>
+#include <memory>
 #include <string>
 #include <filesystem>
 #include <format>
 #include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
 
 using uint8  = uint8_t;
 using uint16 = uint16_t;
@@ -21,8 +25,15 @@ using int64 = int64_t;
 #include "Timer.h"
 #include "Utils.h"
 
+#if DT_PLATFORM_WINDOWS
+	#define DEBUG_BREAK() __debugbreak()
+#else
+	#include <csignal>
+	#define DEBUG_BREAK() std::raise(SIGTRAP)
+#endif
+
 #ifdef DT_DEBUG
-	#define ASSERT(condition) if(!condition) { __debugbreak(); }
+	#define ASSERT(condition) if(!(condition)) { DEBUG_BREAK(); }
 #else
 	#define ASSERT(condition)
 #endif
@@ -41,6 +52,15 @@ static constexpr auto Bit(T x)
 
 namespace DT
 {
-	void InitializeCore();
+	struct CoreSpecification
+	{
+		LogSpecification Logging;
+		uint32 WorkerThreadCount = 0u; // 0 = one per hardware thread besides the main thread
+		ClockSource Clock = ClockSource::Tsc;
+		uint64 ImageCacheBudget = 256ull << 20u; // bytes of decoded images kept by the ImageLoader
+		bool ImageDiskCache = true;              // .dtimg files next to the sources, see ImageCacheFormat.h
+	};
+
+	void InitializeCore(const CoreSpecification& specification = {});
 	void ShutdownCore();
 }
\ No newline at end of file
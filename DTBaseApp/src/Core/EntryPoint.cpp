@@ -1,28 +1,188 @@
 #include "Application.h"
+#include "AllocationTracker.h"
+#include <charconv>
 
-#if DT_PLATFORM_WINDOWS
+#if DT_PLATFORM_WINDOWS || DT_PLATFORM_LINUX
 
-int main()
+/*
+	command line:
+		--headless                        run without a display (see HeadlessWindow)
+		--script <path>                   headless event script
+		--frames <count>                  close the headless window after <count> frames
+		--coalesce-events                 merge redundant mouse move/scroll and window resize events
+		--fixed-step <hz>                 fixed timestep updates at <hz>
+		--fps <target>                    limit the frame rate
+		--idle-unfocused                  block on window events while unfocused
+		--pipelined                       render on a dedicated thread, one frame behind the update
+		--workers <count>                 job system worker threads
+		--async-log                       format and write log messages on a background thread
+		--log-drop-oldest                 asynchronous log overwrites the oldest message instead of blocking
+		--steady-clock                    time with std::chrono::steady_clock instead of the TSC
+		--record-events <path>            record the dispatched events to a memory mapped log
+		--replay-events <path>            replay a recorded event log, in real time
+		--replay-fast                     replay on the recorded frame numbers, as fast as the frame loop runs
+		--profile <path>                  write a Chrome trace of the run (open in chrome://tracing or ui.perfetto.dev)
+		--profile-frames <n>              stop the profiler capture after <n> frames
+		--stats <seconds>                 report frame time percentiles every <seconds>
+		--stats-csv <path>                write the reports to a CSV file instead of the log
+		--frame-budget <ms>               count frames slower than <ms> as budget overruns
+		--max-frame-allocations <count>   exit with 1 if a frame after the warmup allocates more (DT_ENABLE_ALLOCATION_TRACKING)
+		--allocation-warmup <frames>      frames ignored by --max-frame-allocations, default 60
+*/
+struct CommandLine
 {
-	DT::InitializeCore();
+	DT::CoreSpecification Core;
+	DT::ApplicationSpecification Application;
+	std::vector<std::string> UnknownArguments;
+	std::vector<std::string> InvalidArguments; // option and value, the option keeps its default
+	int64 MaxFrameAllocations = -1; // < 0 = no limit
+	uint64 AllocationWarmupFrames = 60u;
+};
 
-	DT::Application* app = new DT::Application({});
+/* the whole text must be a number of type T, value is left untouched otherwise */
+template<typename T>
+static bool ParseValue(std::string_view text, T& value)
+{
+	T parsed = {};
+	auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+	if (error != std::errc() || end != text.data() + text.size())
+		return false;
+
+	value = parsed;
+	return true;
+}
+
+static CommandLine ParseCommandLine(int argc, char** argv)
+{
+	CommandLine commandLine;
+	DT::ApplicationSpecification& specification = commandLine.Application;
+
+	/* consumes the value after the option, a bad one is reported once logging is up */
+	auto value = [&](int& i, const std::string& argument, auto& destination)
+	{
+		const char* text = argv[++i];
+		if (ParseValue(text, destination))
+			return true;
+
+		commandLine.InvalidArguments.emplace_back(argument + " " + text);
+		return false;
+	};
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (argument == "--headless")
+			specification.WindowSpecification.Headless = true;
+		else if (argument == "--script" && hasValue)
+			specification.WindowSpecification.HeadlessScriptPath = argv[++i];
+		else if (argument == "--frames" && hasValue)
+			value(i, argument, specification.WindowSpecification.HeadlessFrameLimit);
+		else if (argument == "--coalesce-events")
+			specification.EventCoalescing = { DT::CoalescePolicy::MergeConsecutive, DT::CoalescePolicy::MergeConsecutive, DT::CoalescePolicy::LatestPerFrame };
+		else if (argument == "--fixed-step" && hasValue)
+		{
+			float rate = 0.0f;
+			if (value(i, argument, rate))
+			{
+				if (rate > 0.0f && std::isfinite(rate))
+				{
+					specification.FrameLoop.Mode = DT::LoopMode::FixedStep;
+					specification.FrameLoop.FixedTimestep = 1.0f / rate;
+				}
+				else
+					commandLine.InvalidArguments.emplace_back(argument + " " + argv[i]);
+			}
+		}
+		else if (argument == "--fps" && hasValue)
+			value(i, argument, specification.FrameLoop.TargetFrameRate);
+		else if (argument == "--idle-unfocused")
+			specification.FrameLoop.IdleWhenUnfocused = true;
+		else if (argument == "--pipelined")
+			specification.FrameLoop.PipelinedRendering = true;
+		else if (argument == "--workers" && hasValue)
+			value(i, argument, commandLine.Core.WorkerThreadCount);
+		else if (argument == "--async-log")
+			commandLine.Core.Logging.Mode = DT::LogMode::Asynchronous;
+		else if (argument == "--log-drop-oldest")
+			commandLine.Core.Logging.OverflowPolicy = DT::LogOverflowPolicy::DropOldest;
+		else if (argument == "--steady-clock")
+			commandLine.Core.Clock = DT::ClockSource::Steady;
+		else if (argument == "--record-events" && hasValue)
+			specification.EventRecording.RecordPath = argv[++i];
+		else if (argument == "--replay-events" && hasValue)
+			specification.EventRecording.ReplayPath = argv[++i];
+		else if (argument == "--replay-fast")
+			specification.EventRecording.Mode = DT::ReplayMode::AsFastAsPossible;
+		else if (argument == "--profile" && hasValue)
+			specification.Profiling.CapturePath = argv[++i];
+		else if (argument == "--profile-frames" && hasValue)
+			value(i, argument, specification.Profiling.CaptureFrameCount);
+		else if (argument == "--stats" && hasValue)
+			value(i, argument, specification.Statistics.ReportInterval);
+		else if (argument == "--stats-csv" && hasValue)
+		{
+			specification.Statistics.Output = DT::FrameStatisticsOutput::Csv;
+			specification.Statistics.CsvPath = argv[++i];
+		}
+		else if (argument == "--frame-budget" && hasValue)
+		{
+			float milliseconds = specification.FrameBudget * 1e3f;
+			value(i, argument, milliseconds);
+			specification.FrameBudget = milliseconds * 1e-3f;
+		}
+		else if (argument == "--max-frame-allocations" && hasValue)
+			value(i, argument, commandLine.MaxFrameAllocations);
+		else if (argument == "--allocation-warmup" && hasValue)
+			value(i, argument, commandLine.AllocationWarmupFrames);
+		else
+			commandLine.UnknownArguments.emplace_back(argument);
+	}
+	return commandLine;
+}
+
+int main(int argc, char** argv)
+{
+	CommandLine commandLine = ParseCommandLine(argc, argv);
+
+	DT::InitializeCore(commandLine.Core);
+	for (const std::string& argument : commandLine.UnknownArguments)
+		LOG_WARN("Unknown command line argument '{}'", argument);
+	for (const std::string& argument : commandLine.InvalidArguments)
+		LOG_WARN("Invalid command line value '{}', the default is kept", argument);
+
+	DT::AllocationTracker::SetWarmupFrames(commandLine.AllocationWarmupFrames);
+	if (commandLine.MaxFrameAllocations >= 0 && !DT::AllocationTracker::IsEnabled())
+		LOG_WARN("--max-frame-allocations needs a build with DT_ENABLE_ALLOCATION_TRACKING, not checked");
+
+	DT::Application* app = new DT::Application(commandLine.Application);
+
+	DT::Timer runTimer;
 	app->Run();
+	if (app->GetWindow().GetSpecification().Headless)
+	{
+		float seconds = runTimer.ElapsedSeconds();
+		LOG_INFO("Headless run: {} frames in {:.3f} s ({:.1f} fps)", app->GetFrameIndex(), seconds, app->GetFrameIndex() / seconds);
+	}
+
 	delete app;
 
-	DT::ShutdownCore();
+	/* allocation gate for CI: a steady state frame is expected not to touch the heap */
+	int exitCode = 0;
+	DT::AllocationStatistics allocations = DT::AllocationTracker::GetStatistics();
+	if (DT::AllocationTracker::IsEnabled() && commandLine.MaxFrameAllocations >= 0 && allocations.MaxFrameAllocations > uint64(commandLine.MaxFrameAllocations))
+	{
+		LOG_ERROR("Frame {} made {} allocations, the limit is {}", allocations.MaxFrameAllocationsFrame, allocations.MaxFrameAllocations, commandLine.MaxFrameAllocations);
+		exitCode = 1;
+	}
 
-	/* Memory Leak Detector: for some reason, spdlog leaks. So disable before testing */
-	
-	/*
-		_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
-		if (_CrtDumpMemoryLeaks())
-			__debugbreak();
-	*/
+	/* leaks and allocation totals are reported here when built with DT_ENABLE_ALLOCATION_TRACKING */
+	DT::ShutdownCore();
 
-	return 0;
+	return exitCode;
 }
 
 #else
-	#error Only Windows Supported!
+	#error Only Windows and Linux Supported!
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <functional>
+#include <array>
 #include "Core.h"
 #include "InputKeyCodes.h"
 
@@ -53,7 +54,9 @@ namespace DT
 			MouseButtonReleased,
 			MouseMoved         ,
 			MouseLeaved        ,
-			MouseScrolled
+			MouseScrolled      ,
+			MouseRawInput      ,
+			Count
 		};
 		enum Category
 		{
@@ -74,6 +77,7 @@ namespace DT
 		bool IsInCategory(Category category) { return GetCategoryFlags() & category; }
 	public:
 		bool Handled = false;
+		uint64 Timestamp = 0u; // Clock time at which the platform produced the event, 0 = unknown (replayed, synthesized)
 	};
 
 	inline std::ostream& operator << (std::ostream& oss, const Event& e)
@@ -81,11 +85,18 @@ namespace DT
 		return oss << e.ToString();
 	}
 
+	static_assert(size_t(Event::Type::Count) <= 64u, "event type masks are 64 bit");
+
+	constexpr uint64 EventTypeBit(Event::Type type)
+	{
+		return Bit<uint64>(uint64(type));
+	}
+
 	/******** reduce boilerplate copy pasta ************/
 	#define IMPLEMENT_CLASS_TYPE(type)                  \
-		static Type GetStaticType()                     \
+		static constexpr Type GetStaticType()           \
 		{                                               \
-			return Type::##type;                        \
+			return Type::type;                          \
 		}                                               \
 		virtual Type GetType() const override           \
 		{                                               \
@@ -97,9 +108,13 @@ namespace DT
 		}                                               \
 												     
 	#define IMPLEMENT_CATEGORIES(categories)            \
+		static constexpr int32 GetStaticCategoryFlags() \
+		{                                               \
+			return int32(categories);                   \
+		}                                               \
 		virtual int32 GetCategoryFlags() const override \
 		{											    \
-			return int32(categories);          	        \
+			return GetStaticCategoryFlags();   	        \
 		}
 
 	/** events from Mouse interaction **/
@@ -208,23 +223,28 @@ namespace DT
 		IMPLEMENT_CATEGORIES(CategoryInput | CategoryMouse)
 	};
 
+	/* unaccelerated relative motion summed over a frame, the individual samples are in Window::GetRawMouseSamples() */
 	class MouseRawInputEvent : public Event
 	{
 	public:
-		MouseRawInputEvent(int32 accX, int32 accY)
-			: m_AccX(accX), m_AccY(accY)
+		MouseRawInputEvent(float deltaX, float deltaY)
+			: m_DeltaX(deltaX), m_DeltaY(deltaY)
 		{}
+
+		float GetDeltaX() const { return m_DeltaX; }
+		float GetDeltaY() const { return m_DeltaY; }
+
 		virtual std::string ToString() const override
 		{
 			std::stringstream ss;
-			ss << "MouseRawInputEvent (accX, accY) = (" << m_AccX << ", " << m_AccY << ")";
+			ss << "MouseRawInputEvent (deltaX, deltaY) = (" << m_DeltaX << ", " << m_DeltaY << ")";
 			return ss.str();
 		}
-		IMPLEMENT_CLASS_TYPE(MouseLeaved)
+		IMPLEMENT_CLASS_TYPE(MouseRawInput)
 		IMPLEMENT_CATEGORIES(CategoryInput | CategoryMouse)
 	private:
-		int32 m_AccX;
-		int32 m_AccY;
+		float m_DeltaX;
+		float m_DeltaY;
 	};
 
 	/** Events from Keyboard interaction **/
@@ -371,4 +391,18 @@ namespace DT
 	private:
 		bool m_Focused;
 	};
+
+	/** categories of every event type, for code that only knows the Event::Type **/
+	template<typename... Events>
+	constexpr std::array<int32, size_t(Event::Type::Count)> MakeEventCategoryTable()
+	{
+		std::array<int32, size_t(Event::Type::Count)> table = {};
+		((table[size_t(Events::GetStaticType())] = Events::GetStaticCategoryFlags()), ...);
+		return table;
+	}
+
+	inline constexpr std::array<int32, size_t(Event::Type::Count)> EventTypeCategories = MakeEventCategoryTable<
+		MouseMovedEvent, MouseScrolledEvent, MouseButtonPressedEvent, MouseButtonReleasedEvent, MouseLeavedEvent, MouseRawInputEvent,
+		KeyPressedEvent, KeyReleasedEvent, KeyTypedEvent,
+		WindowResizeEvent, WindowClosedEvent, WindowFocusEvent, AppTickEvent, AppUpdateEvent, AppRenderEvent>();
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+#include "Event.h"
+#include <array>
+
+namespace DT
+{
+	template<typename T>
+	struct EventHandlerTraits;
+
+	template<typename TOwner, typename TEvent>
+	struct EventHandlerTraits<bool(TOwner::*)(TEvent&)>
+	{
+		using Owner = TOwner;
+		using EventType = TEvent;
+	};
+
+	/*
+		compile time alternative to Event::Dispatcher: the handled types are declared once and
+		dispatch is a single table lookup indexed by Event::Type (no std::function, no allocation)
+
+			using EventHandlers = EventDispatchTable<&MyLayer::OnKeyPressed, &MyLayer::OnWindowFocus>;
+			EventHandlers::Dispatch(*this, event);
+	*/
+	template<auto FirstHandler, auto... Handlers>
+	class EventDispatchTable
+	{
+	public:
+		using Owner = typename EventHandlerTraits<decltype(FirstHandler)>::Owner;
+
+		/* returns true if the event type has a handler, Handled is set to the handler result */
+		static bool Dispatch(Owner& owner, Event& event)
+		{
+			HandlerFn handler = s_Table[size_t(event.GetType())];
+			if (handler == nullptr)
+				return false;
+
+			event.Handled = handler(owner, event);
+			return true;
+		}
+
+		static constexpr bool Handles(Event::Type type)
+		{
+			return s_Table[size_t(type)] != nullptr;
+		}
+
+		/* every handled type, suitable for Layer::SetEventInterest */
+		static constexpr uint64 TypeMask =
+			EventTypeBit(EventHandlerTraits<decltype(FirstHandler)>::EventType::GetStaticType()) |
+			(EventTypeBit(EventHandlerTraits<decltype(Handlers)>::EventType::GetStaticType()) | ... | 0u);
+	private:
+		using HandlerFn = bool(*)(Owner&, Event&);
+
+		template<auto Handler>
+		static bool Invoke(Owner& owner, Event& event)
+		{
+			using EventType = typename EventHandlerTraits<decltype(Handler)>::EventType;
+			return (owner.*Handler)(static_cast<EventType&>(event));
+		}
+
+		template<auto Handler>
+		static constexpr void Register(std::array<HandlerFn, size_t(Event::Type::Count)>& table)
+		{
+			using Traits = EventHandlerTraits<decltype(Handler)>;
+			static_assert(std::is_same_v<typename Traits::Owner, Owner>, "all handlers must belong to the same class");
+			static_assert(std::is_base_of_v<Event, typename Traits::EventType>, "handlers must take an Event type");
+
+			HandlerFn& slot = table[size_t(Traits::EventType::GetStaticType())];
+			if (slot != nullptr)
+				throw "EventDispatchTable: more than one handler for the same event type";
+			slot = &Invoke<Handler>;
+		}
+
+		static constexpr std::array<HandlerFn, size_t(Event::Type::Count)> MakeTable()
+		{
+			std::array<HandlerFn, size_t(Event::Type::Count)> table = {};
+			Register<FirstHandler>(table);
+			(Register<Handlers>(table), ...);
+			return table;
+		}
+	private:
+		static constexpr std::array<HandlerFn, size_t(Event::Type::Count)> s_Table = MakeTable();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "EventQueue.h"
+#include <bit>
+
+namespace DT
+{
+	/* left behind in the slot of an event that was superseded by a later one */
+	class CoalescedEvent : public Event
+	{
+	public:
+		IMPLEMENT_CLASS_TYPE(None)
+		IMPLEMENT_CATEGORIES(CategoryNone)
+	};
+
+	/* constructs merged in target; when target is the slot of previous, previous is destroyed first */
+	template<typename T>
+	static void ReplaceEvent(std::byte* target, const Event& previous, const T& merged, uint64 timestamp)
+	{
+		if (target == reinterpret_cast<const std::byte*>(&previous))
+			previous.~Event();
+
+		T* event = new (target) T(merged);
+		event->Timestamp = timestamp;
+	}
+
+	/* writes the merge of two events of the same type into target, which may be the storage of previous */
+	static void WriteMergedEvent(std::byte* target, const Event& previous, const Event& incoming)
+	{
+		/* the merged event is as late as its oldest part */
+		uint64 timestamp = std::min(previous.Timestamp, incoming.Timestamp);
+
+		switch (incoming.GetType())
+		{
+			case Event::Type::MouseMoved:
+			{
+				ReplaceEvent(target, previous, static_cast<const MouseMovedEvent&>(incoming), timestamp);
+				break;
+			}
+			case Event::Type::WindowResize:
+			{
+				ReplaceEvent(target, previous, static_cast<const WindowResizeEvent&>(incoming), timestamp);
+				break;
+			}
+			case Event::Type::MouseScrolled:
+			{
+				const MouseScrolledEvent& a = static_cast<const MouseScrolledEvent&>(previous);
+				const MouseScrolledEvent& b = static_cast<const MouseScrolledEvent&>(incoming);
+				ReplaceEvent(target, previous, MouseScrolledEvent(a.GetDeltaX() + b.GetDeltaX(), a.GetDeltaY() + b.GetDeltaY()), timestamp);
+				break;
+			}
+			case Event::Type::MouseRawInput:
+			{
+				const MouseRawInputEvent& a = static_cast<const MouseRawInputEvent&>(previous);
+				const MouseRawInputEvent& b = static_cast<const MouseRawInputEvent&>(incoming);
+				ReplaceEvent(target, previous, MouseRawInputEvent(a.GetDeltaX() + b.GetDeltaX(), a.GetDeltaY() + b.GetDeltaY()), timestamp);
+				break;
+			}
+			default:
+			{
+				ASSERT(false);
+				break;
+			}
+		}
+	}
+
+	EventQueue::EventQueue(uint32 capacity)
+	{
+		m_Capacity = std::bit_ceil(std::max(capacity, 1u));
+		m_Mask = m_Capacity - 1u;
+		m_ReservedSlots = m_Capacity / 4u;
+		m_Slots = std::make_unique<Slot[]>(m_Capacity);
+	}
+
+	EventQueue::~EventQueue()
+	{
+		Clear();
+	}
+
+	void EventQueue::Clear()
+	{
+		while (m_Count > 0u)
+		{
+			EventAt(m_Head)->~Event();
+			m_Head++;
+			m_Count--;
+		}
+	}
+
+	void EventQueue::SetCoalescing(const EventCoalescingSpecification& specification)
+	{
+		m_Policies.fill(CoalescePolicy::None);
+		m_Policies[size_t(Event::Type::MouseMoved)]    = specification.MouseMoved;
+		m_Policies[size_t(Event::Type::MouseScrolled)] = specification.MouseScrolled;
+		m_Policies[size_t(Event::Type::WindowResize)]  = specification.WindowResize;
+	}
+
+	bool EventQueue::FindLatest(Event::Type type, uint32& index) const
+	{
+		index = m_LastIndex[size_t(type)];
+
+		bool queued = index - m_Head < m_Count && EventAt(index)->GetType() == type;
+		bool beingDispatched = m_Dispatching && index == m_Head;
+		return queued && !beingDispatched;
+	}
+
+	bool EventQueue::MergeInPlace(const Event& incoming)
+	{
+		uint32 index;
+		if (!FindLatest(incoming.GetType(), index))
+			return false;
+
+		WriteMergedEvent(SlotAt(index), *EventAt(index), incoming);
+		m_Statistics.Coalesced++;
+		return true;
+	}
+
+	bool EventQueue::Coalesce(const Event& incoming, CoalescePolicy policy)
+	{
+		Event::Type type = incoming.GetType();
+		uint32 index;
+		if (!FindLatest(type, index))
+			return false;
+
+		bool isTail = index == m_Head + m_Count - 1u;
+		if (policy == CoalescePolicy::MergeConsecutive && !isTail)
+			return false;
+
+		/* no free slot to move to: merged in place, the event keeps its earlier position */
+		if (isTail || m_Count >= GetSlotLimit(type))
+		{
+			WriteMergedEvent(SlotAt(index), *EventAt(index), incoming);
+		}
+		else
+		{
+			uint32 tail = m_Head + m_Count;
+			WriteMergedEvent(SlotAt(tail), *EventAt(index), incoming);
+
+			EventAt(index)->~Event();
+			new (SlotAt(index)) CoalescedEvent();
+
+			m_LastIndex[size_t(type)] = tail;
+			m_Count++;
+			m_Statistics.HighWaterMark = std::max(m_Statistics.HighWaterMark, m_Count);
+		}
+
+		m_Statistics.Coalesced++;
+		return true;
+	}
+}
\ No newline at end of file
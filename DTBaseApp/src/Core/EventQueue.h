@@ -0,0 +1,158 @@
+#pragma once
+#include "Event.h"
+
+namespace DT
+{
+	enum class CoalescePolicy : uint8
+	{
+		None,             // every event is delivered
+		MergeConsecutive, // back to back events of the same type merge into one
+		LatestPerFrame    // one event per frame, delivered at the position of the latest (in place when the ring is full)
+	};
+
+	/* merging keeps the latest position/size, sums scroll deltas and keeps the oldest timestamp */
+	struct EventCoalescingSpecification
+	{
+		CoalescePolicy MouseMoved    = CoalescePolicy::None;
+		CoalescePolicy MouseScrolled = CoalescePolicy::None;
+		CoalescePolicy WindowResize  = CoalescePolicy::None;
+	};
+
+	/*
+		fixed capacity ring of in-place constructed events: no heap allocations after construction.
+		high rate input (mouse moves, scrolls, raw mouse motion) may only fill the ring up to the reserved slots;
+		past that it merges into the latest queued event of its type, so a burst never crowds out state changes
+		(close, focus, key and button releases), which are only lost if they alone fill the ring
+	*/
+	class EventQueue
+	{
+	public:
+		static constexpr size_t SlotSize = 64u;
+		static constexpr size_t SlotAlignment = 16u;
+
+		struct Statistics
+		{
+			uint64 Pushed = 0u;
+			uint64 Dropped = 0u;
+			uint64 Coalesced = 0u;
+			uint32 HighWaterMark = 0u;
+		};
+	public:
+		EventQueue(uint32 capacity);
+		~EventQueue();
+
+		EventQueue(const EventQueue&) = delete;
+		EventQueue& operator = (const EventQueue&) = delete;
+
+		/*
+			constructs T in the next free slot (or merges it into a queued one), drops the event if there is no room for it.
+			the platform pushes from its callbacks, so the event is timestamped here
+		*/
+		template<typename T, typename... Args>
+		bool Push(Args&&... args)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "T must be an Event");
+			static_assert(sizeof(T) <= SlotSize && alignof(T) <= SlotAlignment, "event does not fit in a queue slot");
+
+			constexpr Event::Type type = T::GetStaticType();
+			CoalescePolicy policy = m_Policies[size_t(type)];
+			bool overLimit = m_Count >= GetSlotLimit(type);
+			if (policy != CoalescePolicy::None || overLimit)
+			{
+				T event(std::forward<Args>(args)...);
+				event.Timestamp = Clock::Now();
+				if (policy != CoalescePolicy::None && Coalesce(event, policy))
+					return true;
+				if (overLimit && IsHighRate(type) && MergeInPlace(event))
+					return true;
+				return Emplace<T>(event);
+			}
+			return Emplace<T>(std::forward<Args>(args)...);
+		}
+
+		/* hands every queued event to fn in push order; events pushed by fn are drained in the same call */
+		template<typename Fn>
+		void Drain(Fn&& fn)
+		{
+			while (m_Count > 0u)
+			{
+				Event* event = EventAt(m_Head);
+				if (event->GetType() != Event::Type::None)
+				{
+					m_Dispatching = true;
+					fn(*event);
+					m_Dispatching = false;
+				}
+				event->~Event();
+
+				m_Head++;
+				m_Count--;
+			}
+		}
+
+		void Clear();
+		void SetCoalescing(const EventCoalescingSpecification& specification);
+
+		uint32 GetCapacity() const { return m_Capacity; }
+		uint32 GetReservedSlots() const { return m_ReservedSlots; } // only state changing events may use them
+		uint32 GetCount() const { return m_Count; }
+		const Statistics& GetStatistics() const { return m_Statistics; }
+		void ResetStatistics() { m_Statistics = {}; }
+	private:
+		struct alignas(SlotAlignment) Slot
+		{
+			std::byte Storage[SlotSize];
+		};
+
+		static constexpr bool IsHighRate(Event::Type type)
+		{
+			return type == Event::Type::MouseMoved || type == Event::Type::MouseScrolled || type == Event::Type::MouseRawInput;
+		}
+
+		uint32 GetSlotLimit(Event::Type type) const { return IsHighRate(type) ? m_Capacity - m_ReservedSlots : m_Capacity; }
+
+		template<typename T, typename... Args>
+		bool Emplace(Args&&... args)
+		{
+			if (m_Count >= GetSlotLimit(T::GetStaticType()))
+			{
+				m_Statistics.Dropped++;
+				return false;
+			}
+
+			uint32 index = m_Head + m_Count;
+			T* event = new (SlotAt(index)) T(std::forward<Args>(args)...);
+			if (event->Timestamp == 0u)
+				event->Timestamp = Clock::Now();
+			m_LastIndex[size_t(T::GetStaticType())] = index;
+			m_Count++;
+
+			m_Statistics.Pushed++;
+			m_Statistics.HighWaterMark = std::max(m_Statistics.HighWaterMark, m_Count);
+			return true;
+		}
+
+		bool Coalesce(const Event& incoming, CoalescePolicy policy);
+		/* merges into the latest queued event of the same type where it stands, false if there is none */
+		bool MergeInPlace(const Event& incoming);
+		/* index of the latest queued event of the type that can still be modified */
+		bool FindLatest(Event::Type type, uint32& index) const;
+
+		std::byte* SlotAt(uint32 index) { return m_Slots[index & m_Mask].Storage; }
+		Event* EventAt(uint32 index) { return std::launder(reinterpret_cast<Event*>(SlotAt(index))); }
+		const Event* EventAt(uint32 index) const { return std::launder(reinterpret_cast<const Event*>(m_Slots[index & m_Mask].Storage)); }
+	private:
+		std::unique_ptr<Slot[]> m_Slots;
+		uint32 m_Capacity = 0u;
+		uint32 m_Mask = 0u;
+		uint32 m_ReservedSlots = 0u;
+		uint32 m_Head = 0u; // free running, masked on access
+		uint32 m_Count = 0u;
+		bool m_Dispatching = false;
+
+		std::array<CoalescePolicy, size_t(Event::Type::Count)> m_Policies = {};
+		std::array<uint32, size_t(Event::Type::Count)> m_LastIndex = {};
+
+		Statistics m_Statistics;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include "EventRecorder.h"
+
+namespace DT
+{
+	static constexpr char s_EventLogMagic[8] = { 'D', 'T', 'E', 'V', 'E', 'N', 'T', 'S' };
+	static constexpr uint32 s_EventLogVersion = 1u;
+	static constexpr uint64 s_InitialLogSize = 1u << 20u;
+
+	static constexpr uint32 s_RecordHeaderSize = sizeof(uint32) + sizeof(uint64) + 2u * sizeof(uint8);
+	static constexpr uint32 s_MaxPayloadSize = 8u;
+
+	template<typename... Values>
+	static uint8 WritePayload(std::byte* payload, const Values&... values)
+	{
+		uint8 size = 0u;
+		((std::memcpy(payload + size, &values, sizeof(Values)), size += sizeof(Values)), ...);
+		return size;
+	}
+
+	template<typename T>
+	static T ReadValue(const std::byte*& source)
+	{
+		T value;
+		std::memcpy(&value, source, sizeof(T));
+		source += sizeof(T);
+		return value;
+	}
+
+	/* returns the payload size, 0xFF for events that are not recorded */
+	static uint8 EncodeEvent(const Event& event, std::byte* payload)
+	{
+		switch (event.GetType())
+		{
+			case Event::Type::MouseMoved:
+			{
+				const MouseMovedEvent& e = static_cast<const MouseMovedEvent&>(event);
+				return WritePayload(payload, e.GetX(), e.GetY());
+			}
+			case Event::Type::MouseScrolled:
+			{
+				const MouseScrolledEvent& e = static_cast<const MouseScrolledEvent&>(event);
+				return WritePayload(payload, e.GetDeltaX(), e.GetDeltaY());
+			}
+			case Event::Type::MouseRawInput:
+			{
+				const MouseRawInputEvent& e = static_cast<const MouseRawInputEvent&>(event);
+				return WritePayload(payload, e.GetDeltaX(), e.GetDeltaY());
+			}
+			case Event::Type::MouseButtonPressed:
+			case Event::Type::MouseButtonReleased:
+				return WritePayload(payload, (int32)static_cast<const MouseButtonEvent&>(event).GetButtonCode());
+			case Event::Type::KeyPressed:
+			{
+				const KeyPressedEvent& e = static_cast<const KeyPressedEvent&>(event);
+				return WritePayload(payload, e.GetKeyCode(), e.GetRepeatCount());
+			}
+			case Event::Type::KeyReleased:
+			case Event::Type::KeyTyped:
+				return WritePayload(payload, static_cast<const KeyEvent&>(event).GetKeyCode());
+			case Event::Type::WindowResize:
+			{
+				const WindowResizeEvent& e = static_cast<const WindowResizeEvent&>(event);
+				return WritePayload(payload, e.GetWidth(), e.GetHeight());
+			}
+			case Event::Type::WindowFocus:
+				return WritePayload(payload, (uint8)static_cast<const WindowFocusEvent&>(event).IsFocused());
+			case Event::Type::WindowClosed:
+			case Event::Type::MouseLeaved:
+				return 0u;
+			default:
+				return 0xFFu;
+		}
+	}
+
+	static Event* DecodeEvent(Event::Type type, const std::byte* payload, std::byte* storage)
+	{
+		switch (type)
+		{
+			case Event::Type::MouseMoved:
+			{
+				int32 x = ReadValue<int32>(payload);
+				int32 y = ReadValue<int32>(payload);
+				return new (storage) MouseMovedEvent(x, y);
+			}
+			case Event::Type::MouseScrolled:
+			{
+				float deltaX = ReadValue<float>(payload);
+				float deltaY = ReadValue<float>(payload);
+				return new (storage) MouseScrolledEvent(deltaX, deltaY);
+			}
+			case Event::Type::MouseRawInput:
+			{
+				float deltaX = ReadValue<float>(payload);
+				float deltaY = ReadValue<float>(payload);
+				return new (storage) MouseRawInputEvent(deltaX, deltaY);
+			}
+			case Event::Type::MouseButtonPressed:  return new (storage) MouseButtonPressedEvent(ReadValue<int32>(payload));
+			case Event::Type::MouseButtonReleased: return new (storage) MouseButtonReleasedEvent(ReadValue<int32>(payload));
+			case Event::Type::KeyPressed:
+			{
+				int32 key = ReadValue<int32>(payload);
+				int32 repeatCount = ReadValue<int32>(payload);
+				return new (storage) KeyPressedEvent(key, repeatCount);
+			}
+			case Event::Type::KeyReleased: return new (storage) KeyReleasedEvent(ReadValue<int32>(payload));
+			case Event::Type::KeyTyped:    return new (storage) KeyTypedEvent(ReadValue<int32>(payload));
+			case Event::Type::WindowResize:
+			{
+				int32 width = ReadValue<int32>(payload);
+				int32 height = ReadValue<int32>(payload);
+				return new (storage) WindowResizeEvent(width, height);
+			}
+			case Event::Type::WindowFocus:  return new (storage) WindowFocusEvent(ReadValue<uint8>(payload) != 0u);
+			case Event::Type::WindowClosed: return new (storage) WindowClosedEvent();
+			case Event::Type::MouseLeaved:  return new (storage) MouseLeavedEvent();
+			default:                        return nullptr;
+		}
+	}
+
+	EventRecorder::~EventRecorder()
+	{
+		Stop();
+	}
+
+	bool EventRecorder::Start(const std::filesystem::path& filePath, uint64 startFrame)
+	{
+		if (!m_File.Open(filePath, MappedFileAccess::ReadWrite, s_InitialLogSize))
+		{
+			LOG_ERROR("Could not create event log {}", filePath.string());
+			return false;
+		}
+
+		EventLogHeader* header = reinterpret_cast<EventLogHeader*>(m_File.GetData());
+		std::memcpy(header->Magic, s_EventLogMagic, sizeof(header->Magic));
+		header->Version = s_EventLogVersion;
+		header->RecordCount = 0u;
+		header->UsedBytes = sizeof(EventLogHeader);
+
+		m_StartFrame = startFrame;
+		m_StartTime = Clock::Now();
+		return true;
+	}
+
+	void EventRecorder::Stop()
+	{
+		if (!IsRecording())
+			return;
+
+		const EventLogHeader* header = reinterpret_cast<const EventLogHeader*>(m_File.GetData());
+		uint64 usedBytes = header->UsedBytes;
+		LOG_TRACE("Recorded {} events ({} bytes)", header->RecordCount, usedBytes);
+
+		m_File.Flush();
+		m_File.Close(usedBytes);
+	}
+
+	void EventRecorder::Record(uint64 frameIndex, const Event& event)
+	{
+		std::byte payload[s_MaxPayloadSize];
+		uint8 payloadSize = EncodeEvent(event, payload);
+		if (payloadSize == 0xFFu)
+			return;
+
+		uint64 usedBytes = reinterpret_cast<const EventLogHeader*>(m_File.GetData())->UsedBytes;
+		uint64 recordSize = s_RecordHeaderSize + payloadSize;
+		if (usedBytes + recordSize > m_File.GetSize() && !m_File.Resize(m_File.GetSize() * 2u))
+		{
+			LOG_ERROR("Could not grow the event log, recording stopped");
+			m_File.Close(usedBytes);
+			return;
+		}
+
+		std::byte* record = m_File.GetData() + usedBytes;
+		uint32 frame = uint32(frameIndex - m_StartFrame);
+		uint64 time = Clock::Now() - m_StartTime;
+		uint8 type = (uint8)event.GetType();
+		record += WritePayload(record, frame, time, type, payloadSize);
+		std::memcpy(record, payload, payloadSize);
+
+		/* published last: a crash mid record leaves the previous records intact */
+		EventLogHeader* header = reinterpret_cast<EventLogHeader*>(m_File.GetData());
+		header->RecordCount++;
+		header->UsedBytes = usedBytes + recordSize;
+	}
+
+	bool EventReplayer::Open(const std::filesystem::path& filePath, ReplayMode mode)
+	{
+		Close();
+		if (!m_File.Open(filePath, MappedFileAccess::Read) || m_File.GetSize() < sizeof(EventLogHeader))
+		{
+			LOG_ERROR("Could not open event log {}", filePath.string());
+			m_File.Close();
+			return false;
+		}
+
+		const EventLogHeader* header = reinterpret_cast<const EventLogHeader*>(m_File.GetData());
+		if (std::memcmp(header->Magic, s_EventLogMagic, sizeof(header->Magic)) != 0 || header->Version != s_EventLogVersion)
+		{
+			LOG_ERROR("{} is not an event log of version {}", filePath.string(), s_EventLogVersion);
+			m_File.Close();
+			return false;
+		}
+
+		m_Mode = mode;
+		m_Offset = sizeof(EventLogHeader);
+		m_End = std::min(header->UsedBytes, m_File.GetSize());
+		m_RecordCount = header->RecordCount;
+		m_FirstFrame = ~0ull;
+		return true;
+	}
+
+	void EventReplayer::Close()
+	{
+		m_File.Close();
+		m_Offset = 0u;
+		m_End = 0u;
+	}
+
+	void EventReplayer::BeginFrame(uint64 frameIndex)
+	{
+		if (m_FirstFrame == ~0ull)
+		{
+			m_FirstFrame = frameIndex;
+			m_StartTime = Clock::Now();
+		}
+
+		m_CurrentFrame = frameIndex - m_FirstFrame;
+		m_CurrentTime = Clock::Now() - m_StartTime;
+	}
+
+	Event* EventReplayer::NextDueEvent(std::byte* storage)
+	{
+		/* records of unknown types are skipped, a loop so a corrupt or foreign log cannot exhaust the stack */
+		while (!IsFinished() && m_Offset + s_RecordHeaderSize <= m_End)
+		{
+			const std::byte* record = m_File.GetData() + m_Offset;
+			uint32 frame = ReadValue<uint32>(record);
+			uint64 time = ReadValue<uint64>(record);
+			Event::Type type = Event::Type(ReadValue<uint8>(record));
+			uint8 payloadSize = ReadValue<uint8>(record);
+
+			bool due = m_Mode == ReplayMode::RealTime ? time <= m_CurrentTime : frame <= m_CurrentFrame;
+			if (!due)
+				return nullptr;
+
+			m_Offset += s_RecordHeaderSize + payloadSize;
+			if (m_Offset > m_End)
+				return nullptr;
+
+			if (Event* event = DecodeEvent(type, record, storage))
+				return event;
+		}
+		return nullptr;
+	}
+}
\ No newline at end of file
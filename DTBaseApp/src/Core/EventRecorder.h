@@ -0,0 +1,85 @@
+#pragma once
+#include "Event.h"
+#include "MappedFile.h"
+
+namespace DT
+{
+	/*
+		event log layout: EventLogHeader, then one record per event
+			uint32 frame | uint64 nanoseconds | uint8 type | uint8 payload size | payload
+		frame and time are relative to the start of the recording, UsedBytes is kept current after
+		every record so the log of a crashed session is still readable
+	*/
+	struct EventLogHeader
+	{
+		char Magic[8];
+		uint32 Version;
+		uint32 RecordCount;
+		uint64 UsedBytes;
+	};
+
+	/* appends the events the application dispatches to a memory mapped log */
+	class EventRecorder
+	{
+	public:
+		~EventRecorder();
+
+		/* frames and times are recorded relative to startFrame and the time of the call */
+		bool Start(const std::filesystem::path& filePath, uint64 startFrame = 0u);
+		void Stop();
+		bool IsRecording() const { return m_File.IsOpen(); }
+
+		void Record(uint64 frameIndex, const Event& event);
+	private:
+		MappedFile m_File;
+		uint64 m_StartFrame = 0u;
+		uint64 m_StartTime = 0u;
+	};
+
+	enum class ReplayMode
+	{
+		RealTime,        // events are injected when their recorded time has passed
+		AsFastAsPossible // events are injected on their recorded frame, whatever the frame rate
+	};
+
+	/* injects the events of a recorded log frame by frame */
+	class EventReplayer
+	{
+	public:
+		bool Open(const std::filesystem::path& filePath, ReplayMode mode);
+		void Close();
+		bool IsOpen() const { return m_File.IsOpen(); }
+		bool IsFinished() const { return m_Offset >= m_End; }
+
+		uint32 GetRecordCount() const { return m_RecordCount; }
+
+		/* calls fn(Event&) for every event due at frameIndex, the first call starts the replay clock */
+		template<typename Fn>
+		void ReplayFrame(uint64 frameIndex, Fn&& fn)
+		{
+			BeginFrame(frameIndex);
+
+			alignas(16) std::byte storage[64];
+			while (Event* event = NextDueEvent(storage))
+			{
+				fn(*event);
+				event->~Event();
+			}
+		}
+	private:
+		void BeginFrame(uint64 frameIndex);
+		/* constructs the next due event in storage, nullptr once nothing else is due this frame */
+		Event* NextDueEvent(std::byte* storage);
+	private:
+		MappedFile m_File;
+		ReplayMode m_Mode = ReplayMode::RealTime;
+		uint64 m_Offset = 0u;
+		uint64 m_End = 0u;
+		uint32 m_RecordCount = 0u;
+
+		uint64 m_FirstFrame = ~0ull;
+		uint64 m_StartTime = 0u;
+		uint64 m_CurrentFrame = 0u;
+		uint64 m_CurrentTime = 0u;
+	};
+}
\ No newline at end of file
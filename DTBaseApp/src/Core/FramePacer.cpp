@@ -0,0 +1,64 @@
+#include "FramePacer.h"
+#include <thread>
+
+namespace DT
+{
+	FramePacer::FramePacer(float targetFrameRate)
+	{
+		SetTargetFrameRate(targetFrameRate);
+	}
+
+	void FramePacer::SetTargetFrameRate(float targetFrameRate)
+	{
+		if (targetFrameRate > 0.0f)
+			m_FrameDuration = Clock::FromSeconds(1.0 / targetFrameRate);
+		else
+			m_FrameDuration = 0u;
+
+		m_Deadline = 0u;
+	}
+
+	void FramePacer::Wait()
+	{
+		if (!IsEnabled())
+			return;
+
+		uint64 now = Clock::Now();
+		if (m_Deadline == 0u)
+		{
+			m_Deadline = now + m_FrameDuration;
+			return;
+		}
+
+		while (now < m_Deadline && Clock::ToSeconds(m_Deadline - now) > m_SleepEstimate)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+			uint64 woke = Clock::Now();
+			UpdateSleepEstimate(Clock::ToSeconds(woke - now));
+			now = woke;
+		}
+
+		while (now < m_Deadline)
+		{
+			std::this_thread::yield();
+			now = Clock::Now();
+		}
+
+		/* a missed deadline starts a new schedule instead of rushing frames to catch up */
+		m_Deadline += m_FrameDuration;
+		if (m_Deadline < now)
+			m_Deadline = now + m_FrameDuration;
+	}
+
+	void FramePacer::UpdateSleepEstimate(double observedSeconds)
+	{
+		m_SleepCount++;
+		double delta = observedSeconds - m_SleepMean;
+		m_SleepMean += delta / double(m_SleepCount);
+		m_SleepM2 += delta * (observedSeconds - m_SleepMean);
+
+		double stddev = std::sqrt(m_SleepM2 / double(m_SleepCount - 1u));
+		m_SleepEstimate = m_SleepMean + stddev;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+#include "Core.h"
+
+namespace DT
+{
+	/* holds the frame rate to a target: sleeps while the OS can be trusted to wake up in time, then spins */
+	class FramePacer
+	{
+	public:
+		FramePacer(float targetFrameRate = 0.0f);
+
+		void SetTargetFrameRate(float targetFrameRate);
+		bool IsEnabled() const { return m_FrameDuration > 0u; }
+
+		/* blocks until the deadline of the current frame and schedules the next one */
+		void Wait();
+	private:
+		void UpdateSleepEstimate(double observedSeconds);
+	private:
+		/* Clock nanoseconds, a deadline of 0 means the schedule has not started */
+		uint64 m_FrameDuration = 0u;
+		uint64 m_Deadline = 0u;
+
+		/* running mean/variance of how long a 1ms sleep really takes */
+		double m_SleepEstimate = 5e-3;
+		double m_SleepMean = 5e-3;
+		double m_SleepM2 = 0.0;
+		uint64 m_SleepCount = 1u;
+	};
+}
\ No newline at end of file
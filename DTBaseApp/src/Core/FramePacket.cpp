@@ -0,0 +1,30 @@
+#include "FramePacket.h"
+
+namespace DT
+{
+	FramePacket::~FramePacket()
+	{
+		Reset();
+	}
+
+	void FramePacket::Reset()
+	{
+		for (size_t i = m_Entries.size(); i > 0u; i--)
+		{
+			if (m_Entries[i - 1].Destroy)
+				m_Entries[i - 1].Destroy(m_Entries[i - 1].Data);
+		}
+
+		m_Entries.clear();
+		m_Arena.Reset();
+		m_InputTiming = {};
+	}
+
+	void FramePacket::Begin(uint64 frameIndex, float deltaTime, float alpha, const std::vector<Layer*>& layers)
+	{
+		m_FrameIndex = frameIndex;
+		m_DeltaTime = deltaTime;
+		m_Alpha = alpha;
+		m_Layers.assign(layers.begin(), layers.end());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+#include "Core.h"
+#include "LinearArena.h"
+#include <typeinfo>
+
+namespace DT
+{
+	class Layer;
+
+	/*
+		hand-off between update and render: layers write their per-frame data during OnPrepareRender,
+		the render phase only reads it (possibly on the render thread while the next frame updates).
+		The packet owns the frame arena: everything allocated from it lives until the packet is reset
+	*/
+	class FramePacket
+	{
+	public:
+		/* Clock timestamps of the input events consumed by the frame, their latency is taken once the packet is rendered */
+		struct InputTiming
+		{
+			uint64 Oldest = ~0ull;
+			uint64 Newest = 0u;
+			uint64 First = 0u;
+			int64 OffsetSum = 0; // relative to First, absolute timestamps would overflow the sum
+			uint32 Count = 0u;
+
+			void Add(uint64 timestamp)
+			{
+				if (Count == 0u)
+					First = timestamp;
+				Oldest = std::min(Oldest, timestamp);
+				Newest = std::max(Newest, timestamp);
+				OffsetSum += int64(timestamp - First);
+				Count++;
+			}
+
+			uint64 GetMean() const { return Count > 0u ? uint64(int64(First) + OffsetSum / int64(Count)) : 0u; }
+		};
+	public:
+		FramePacket() = default;
+		~FramePacket();
+
+		FramePacket(const FramePacket&) = delete;
+		FramePacket& operator = (const FramePacket&) = delete;
+
+		/* destroys the data of the previous use and empties the arena */
+		void Reset();
+		void Begin(uint64 frameIndex, float deltaTime, float alpha, const std::vector<Layer*>& layers);
+		void SetInputTiming(const InputTiming& timing) { m_InputTiming = timing; }
+
+		template<typename T, typename... Args>
+		T& Emplace(const Layer* owner, Args&&... args)
+		{
+			T* object = m_Arena.New<T>(std::forward<Args>(args)...);
+
+			Entry& entry = m_Entries.emplace_back();
+			entry.Owner = owner;
+			entry.Type = &typeid(T);
+			entry.Data = object;
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				entry.Destroy = [](void* data) { static_cast<T*>(data)->~T(); };
+
+			return *object;
+		}
+
+		/* first object of type T written by owner this frame, nullptr if none */
+		template<typename T>
+		const T* Find(const Layer* owner) const
+		{
+			for (const Entry& entry : m_Entries)
+			{
+				if (entry.Owner == owner && *entry.Type == typeid(T))
+					return static_cast<const T*>(entry.Data);
+			}
+			return nullptr;
+		}
+
+		uint64 GetFrameIndex() const { return m_FrameIndex; }
+		float GetDeltaTime() const { return m_DeltaTime; }
+		float GetAlpha() const { return m_Alpha; }
+		const std::vector<Layer*>& GetLayers() const { return m_Layers; }
+		const InputTiming& GetInputTiming() const { return m_InputTiming; }
+
+		LinearArena& GetArena() { return m_Arena; }
+		const LinearArena& GetArena() const { return m_Arena; }
+	private:
+		struct Entry
+		{
+			const Layer* Owner = nullptr;
+			const std::type_info* Type = nullptr;
+			void* Data = nullptr;
+			void (*Destroy)(void* data) = nullptr;
+		};
+
+		uint64 m_FrameIndex = 0u;
+		float m_DeltaTime = 0.0f;
+		float m_Alpha = 1.0f;
+		std::vector<Layer*> m_Layers;
+		InputTiming m_InputTiming;
+
+		std::vector<Entry> m_Entries;
+		LinearArena m_Arena;
+	};
+}
\ No newline at end of file
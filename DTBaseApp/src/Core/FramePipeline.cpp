@@ -0,0 +1,87 @@
+#include "FramePipeline.h"
+#include "Profiler.h"
+
+namespace DT
+{
+	FramePipeline::~FramePipeline()
+	{
+		Stop();
+	}
+
+	void FramePipeline::Start(uint32 framesInFlight, const RenderFn& render)
+	{
+		ASSERT(!IsRunning());
+
+		m_Packets.clear();
+		for (uint32 i = 0u; i < std::max(framesInFlight, 1u) + 1u; i++)
+			m_Packets.emplace_back(std::make_unique<FramePacket>());
+
+		m_Render = render;
+		m_Submitted = 0u;
+		m_Rendered = 0u;
+		m_StopRequested = false;
+		m_Thread = std::thread(&FramePipeline::RenderThreadMain, this);
+	}
+
+	void FramePipeline::Stop()
+	{
+		if (!IsRunning())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_StopRequested = true;
+		}
+		m_Condition.notify_all();
+		m_Thread.join();
+	}
+
+	FramePacket& FramePipeline::AcquirePacket()
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Condition.wait(lock, [this]
+		{
+			return m_Submitted - m_Rendered < m_Packets.size();
+		});
+		return *m_Packets[m_Submitted % m_Packets.size()];
+	}
+
+	void FramePipeline::SubmitPacket()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Submitted++;
+		}
+		m_Condition.notify_all();
+	}
+
+	void FramePipeline::RenderThreadMain()
+	{
+		PROFILE_THREAD_NAME("Render");
+
+		while (true)
+		{
+			FramePacket* packet = nullptr;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_Condition.wait(lock, [this]
+				{
+					return m_Rendered < m_Submitted || m_StopRequested;
+				});
+
+				if (m_Rendered == m_Submitted)
+					return;
+
+				packet = m_Packets[m_Rendered % m_Packets.size()].get();
+			}
+
+			m_Render(*packet);
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Rendered++;
+			}
+			m_Condition.notify_all();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include "FramePacket.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace DT
+{
+	/* render thread fed with frame packets: update of frame N+1 overlaps the render of frame N */
+	class FramePipeline
+	{
+	public:
+		using RenderFn = std::function<void(const FramePacket& packet)>;
+
+		FramePipeline() = default;
+		~FramePipeline();
+
+		/* framesInFlight: how many submitted frames the render thread may lag behind */
+		void Start(uint32 framesInFlight, const RenderFn& render);
+		/* renders every submitted packet, then joins the render thread */
+		void Stop();
+
+		bool IsRunning() const { return m_Thread.joinable(); }
+		const std::vector<std::unique_ptr<FramePacket>>& GetPackets() const { return m_Packets; }
+
+		/* blocks until a packet is no longer used by the render thread */
+		FramePacket& AcquirePacket();
+		/* hands the packet returned by AcquirePacket to the render thread */
+		void SubmitPacket();
+	private:
+		void RenderThreadMain();
+	private:
+		std::vector<std::unique_ptr<FramePacket>> m_Packets;
+		RenderFn m_Render;
+		std::thread m_Thread;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		uint64 m_Submitted = 0u;
+		uint64 m_Rendered = 0u;
+		bool m_StopRequested = false;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "FrameStatistics.h"
+#include <bit>
+
+namespace DT
+{
+	void FrameTimeHistogram::Record(uint64 nanoseconds)
+	{
+		m_Buckets[BucketIndex(nanoseconds)].fetch_add(1u, std::memory_order_relaxed);
+		m_Count.fetch_add(1u, std::memory_order_relaxed);
+		m_Total.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+		uint64 max = m_Max.load(std::memory_order_relaxed);
+		while (nanoseconds > max && !m_Max.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {}
+	}
+
+	void FrameTimeHistogram::Reset()
+	{
+		for (std::atomic<uint64>& bucket : m_Buckets)
+			bucket.store(0u, std::memory_order_relaxed);
+		m_Count.store(0u, std::memory_order_relaxed);
+		m_Total.store(0u, std::memory_order_relaxed);
+		m_Max.store(0u, std::memory_order_relaxed);
+	}
+
+	double FrameTimeHistogram::GetMean() const
+	{
+		uint64 count = GetCount();
+		return count > 0u ? double(m_Total.load(std::memory_order_relaxed)) / double(count) : 0.0;
+	}
+
+	uint64 FrameTimeHistogram::GetPercentile(double percentile) const
+	{
+		/* ranks over the buckets themselves, a Record running concurrently may not have reached m_Count yet */
+		std::array<uint64, s_BucketCount> buckets;
+		uint64 count = 0u;
+		for (uint32 i = 0u; i < s_BucketCount; i++)
+		{
+			buckets[i] = m_Buckets[i].load(std::memory_order_relaxed);
+			count += buckets[i];
+		}
+		if (count == 0u)
+			return 0u;
+
+		uint64 max = GetMax();
+		uint64 rank = std::max<uint64>((uint64)std::ceil(percentile * 0.01 * double(count)), 1u);
+		uint64 seen = 0u;
+		for (uint32 i = 0u; i < s_BucketCount; i++)
+		{
+			seen += buckets[i];
+			if (seen >= rank)
+				return std::min(BucketMidpoint(i), max);
+		}
+		return max;
+	}
+
+	uint32 FrameTimeHistogram::BucketIndex(uint64 nanoseconds)
+	{
+		/* values below 2 * s_SubBucketCount map to themselves */
+		if (nanoseconds < 2u * s_SubBucketCount)
+			return (uint32)nanoseconds;
+
+		uint32 exponent = std::min<uint32>((uint32)std::bit_width(nanoseconds) - 1u, s_MaxExponent);
+		uint32 shift = exponent - s_SubBucketBits;
+		uint64 subBucket = std::min<uint64>(nanoseconds >> shift, 2u * s_SubBucketCount - 1u); // [32, 64)
+		return shift * s_SubBucketCount + (uint32)subBucket;
+	}
+
+	uint64 FrameTimeHistogram::BucketMidpoint(uint32 index)
+	{
+		if (index < 2u * s_SubBucketCount)
+			return index;
+
+		uint32 shift = index / s_SubBucketCount - 1u;
+		uint64 subBucket = index % s_SubBucketCount + s_SubBucketCount;
+		return (subBucket << shift) + (uint64(1u) << (shift - 1u));
+	}
+
+	void FrameStatistics::Configure(const FrameStatisticsSpecification& specification)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Specification = specification;
+		m_ReportTimer.Reset();
+
+		m_Csv.close();
+		if (m_Specification.Output == FrameStatisticsOutput::Csv && m_Specification.ReportInterval > 0.0f)
+		{
+			m_Csv.open(m_Specification.CsvPath);
+			if (m_Csv)
+				m_Csv << "time,series,count,mean_ms,p50_ms,p95_ms,p99_ms,max_ms,budget_ms,overruns\n";
+			else
+				LOG_ERROR("Could not open frame statistics file {}", m_Specification.CsvPath.string());
+		}
+	}
+
+	uint32 FrameStatistics::AddSeries(const std::string& name, uint64 budgetNanoseconds)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		uint32 index = m_SeriesCount.load(std::memory_order_relaxed);
+		if (index == MaxSeries)
+		{
+			LOG_WARN("FrameStatistics holds at most {} series, {} is not recorded", MaxSeries, name);
+			return InvalidSeries;
+		}
+
+		m_Series[index] = std::make_unique<Series>();
+		m_Series[index]->Name = name;
+		m_Series[index]->Budget.store(budgetNanoseconds, std::memory_order_relaxed);
+		m_SeriesCount.store(index + 1u, std::memory_order_release);
+		return index;
+	}
+
+	void FrameStatistics::SetBudget(uint32 series, uint64 budgetNanoseconds)
+	{
+		if (series != InvalidSeries)
+			m_Series[series]->Budget.store(budgetNanoseconds, std::memory_order_relaxed);
+	}
+
+	void FrameStatistics::Record(uint32 series, uint64 nanoseconds)
+	{
+		if (series == InvalidSeries)
+			return;
+
+		/* called from job workers in the middle of parallel updates: no lock, only relaxed atomics */
+		Series& target = *m_Series[series];
+		target.Histogram.Record(nanoseconds);
+		uint64 budget = target.Budget.load(std::memory_order_relaxed);
+		if (budget > 0u && nanoseconds > budget)
+		{
+			target.Overruns.fetch_add(1u, std::memory_order_relaxed);
+			target.TotalOverruns.fetch_add(1u, std::memory_order_relaxed);
+		}
+	}
+
+	void FrameStatistics::EndFrame()
+	{
+		if (m_Specification.ReportInterval <= 0.0f || m_ReportTimer.ElapsedSeconds() < m_Specification.ReportInterval)
+			return;
+
+		m_ReportTimer.Reset();
+		Report();
+		ResetWindow();
+	}
+
+	void FrameStatistics::Report()
+	{
+		constexpr double toMilliseconds = 1e-6;
+
+		std::vector<FrameStatisticsSummary> summaries = GetSummaries();
+		if (m_Csv.is_open())
+		{
+			double time = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+			for (const FrameStatisticsSummary& summary : summaries)
+			{
+				m_Csv << std::format("{:.3f},{},{},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{}\n", time, summary.Name, summary.Count,
+					summary.Mean * toMilliseconds, summary.P50 * toMilliseconds, summary.P95 * toMilliseconds, summary.P99 * toMilliseconds,
+					summary.Max * toMilliseconds, summary.Budget * toMilliseconds, summary.Overruns);
+			}
+			m_Csv.flush();
+			return;
+		}
+
+		for (const FrameStatisticsSummary& summary : summaries)
+		{
+			if (summary.Count == 0u)
+				continue;
+
+			LOG_INFO("{:<24} n={:<6} mean={:.3f}ms p50={:.3f}ms p95={:.3f}ms p99={:.3f}ms max={:.3f}ms", summary.Name, summary.Count,
+				summary.Mean * toMilliseconds, summary.P50 * toMilliseconds, summary.P95 * toMilliseconds, summary.P99 * toMilliseconds, summary.Max * toMilliseconds);
+			if (summary.Overruns > 0u)
+				LOG_WARN("{} over its {:.3f}ms budget {} of {} times ({} since start)", summary.Name, summary.Budget * toMilliseconds, summary.Overruns, summary.Count, summary.TotalOverruns);
+		}
+	}
+
+	void FrameStatistics::ResetWindow()
+	{
+		uint32 count = m_SeriesCount.load(std::memory_order_acquire);
+		for (uint32 i = 0u; i < count; i++)
+		{
+			m_Series[i]->Histogram.Reset();
+			m_Series[i]->Overruns.store(0u, std::memory_order_relaxed);
+		}
+	}
+
+	FrameStatisticsSummary FrameStatistics::GetSummary(uint32 series) const
+	{
+		if (series == InvalidSeries)
+			return {};
+		return Summarize(*m_Series[series]);
+	}
+
+	std::vector<FrameStatisticsSummary> FrameStatistics::GetSummaries() const
+	{
+		uint32 count = m_SeriesCount.load(std::memory_order_acquire);
+		std::vector<FrameStatisticsSummary> summaries;
+		summaries.reserve(count);
+		for (uint32 i = 0u; i < count; i++)
+			summaries.emplace_back(Summarize(*m_Series[i]));
+		return summaries;
+	}
+
+	FrameStatisticsSummary FrameStatistics::Summarize(const Series& series) const
+	{
+		const FrameTimeHistogram& histogram = series.Histogram;
+
+		FrameStatisticsSummary summary;
+		summary.Name = series.Name;
+		summary.Count = histogram.GetCount();
+		summary.Mean = histogram.GetMean();
+		summary.P50 = histogram.GetPercentile(50.0);
+		summary.P95 = histogram.GetPercentile(95.0);
+		summary.P99 = histogram.GetPercentile(99.0);
+		summary.Max = histogram.GetMax();
+		summary.Budget = series.Budget.load(std::memory_order_relaxed);
+		summary.Overruns = series.Overruns.load(std::memory_order_relaxed);
+		summary.TotalOverruns = series.TotalOverruns.load(std::memory_order_relaxed);
+		return summary;
+	}
+}
\ No newline at end of file
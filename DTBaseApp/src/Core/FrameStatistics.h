@@ -0,0 +1,126 @@
+#pragma once
+#include "Core.h"
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+
+namespace DT
+{
+	/*
+		log-linear (HDR style) histogram of nanosecond durations: exact below 64ns, above that
+		every power of two is split into 32 buckets, so any percentile is within ~3%.
+		Record is lock free and can run on several threads at once, readers see relaxed counters
+	*/
+	class FrameTimeHistogram
+	{
+	public:
+		void Record(uint64 nanoseconds);
+		void Reset();
+
+		uint64 GetCount() const { return m_Count.load(std::memory_order_relaxed); }
+		uint64 GetMax() const { return m_Max.load(std::memory_order_relaxed); }
+		double GetMean() const;
+		/* percentile in [0, 100] */
+		uint64 GetPercentile(double percentile) const;
+	private:
+		static constexpr uint32 s_SubBucketBits = 5u;
+		static constexpr uint32 s_SubBucketCount = 1u << s_SubBucketBits;
+		static constexpr uint32 s_MaxExponent = 47u; // ~39 hours
+		static constexpr uint32 s_BucketCount = (s_MaxExponent - s_SubBucketBits + 1u) * s_SubBucketCount + s_SubBucketCount;
+
+		static uint32 BucketIndex(uint64 nanoseconds);
+		static uint64 BucketMidpoint(uint32 index);
+	private:
+		std::array<std::atomic<uint64>, s_BucketCount> m_Buckets = {};
+		std::atomic<uint64> m_Count = 0u;
+		std::atomic<uint64> m_Total = 0u;
+		std::atomic<uint64> m_Max = 0u;
+	};
+
+	enum class FrameStatisticsOutput
+	{
+		Log,
+		Csv
+	};
+
+	struct FrameStatisticsSpecification
+	{
+		float ReportInterval = 0.0f; // seconds, 0 = never report, the window then covers the whole run
+		FrameStatisticsOutput Output = FrameStatisticsOutput::Log;
+		std::filesystem::path CsvPath = "FrameStatistics.csv";
+	};
+
+	struct FrameStatisticsSummary
+	{
+		std::string Name;
+		uint64 Count = 0u;
+		double Mean = 0.0; // nanoseconds
+		uint64 P50 = 0u;
+		uint64 P95 = 0u;
+		uint64 P99 = 0u;
+		uint64 Max = 0u;
+		uint64 Budget = 0u;         // 0 = no budget
+		uint64 Overruns = 0u;       // samples above the budget in the current window
+		uint64 TotalOverruns = 0u;  // since the start
+	};
+
+	/* named series of durations, the window restarts after every report; Record is thread safe and takes no lock */
+	class FrameStatistics
+	{
+	public:
+		static constexpr uint32 InvalidSeries = ~0u;
+		static constexpr uint32 MaxSeries = 256u; // AddSeries returns InvalidSeries beyond it
+
+		/* records the lifetime of the scope into a series */
+		class Scope
+		{
+		public:
+			Scope(FrameStatistics& statistics, uint32 series)
+				: m_Statistics(statistics), m_Series(series), m_Start(Timer::Now()) {}
+			~Scope() { m_Statistics.Record(m_Series, Timer::Now() - m_Start); }
+
+			Scope(const Scope&) = delete;
+			Scope& operator = (const Scope&) = delete;
+		private:
+			FrameStatistics& m_Statistics;
+			uint32 m_Series;
+			uint64 m_Start;
+		};
+	public:
+		void Configure(const FrameStatisticsSpecification& specification);
+
+		uint32 AddSeries(const std::string& name, uint64 budgetNanoseconds = 0u);
+		void SetBudget(uint32 series, uint64 budgetNanoseconds);
+
+		void Record(uint32 series, uint64 nanoseconds);
+
+		/* reports and restarts the window once ReportInterval has passed */
+		void EndFrame();
+		void Report();
+		void ResetWindow();
+
+		FrameStatisticsSummary GetSummary(uint32 series) const;
+		std::vector<FrameStatisticsSummary> GetSummaries() const;
+	private:
+		struct Series
+		{
+			std::string Name;
+			std::atomic<uint64> Budget = 0u;
+			std::atomic<uint64> Overruns = 0u;
+			std::atomic<uint64> TotalOverruns = 0u;
+			FrameTimeHistogram Histogram;
+		};
+
+		FrameStatisticsSummary Summarize(const Series& series) const;
+	private:
+		/* guards configuration and the CSV file; series never move, so Record can index them without it */
+		mutable std::mutex m_Mutex;
+		std::array<std::unique_ptr<Series>, MaxSeries> m_Series;
+		std::atomic<uint32> m_SeriesCount = 0u;
+
+		FrameStatisticsSpecification m_Specification;
+		Timer m_ReportTimer;
+		std::ofstream m_Csv;
+	};
+}
\ No newline at end of file
@@ -1,28 +1,45 @@
 #include "Input.h"
 #include "Application.h"
-#include "Platform/WindowsWindow.h"
 
 namespace DT
 {
     bool Input::KeyIsPressed(KeyCode key)
     {
-        WindowsWindow* window = (WindowsWindow*)&Application::Get().GetWindow();
-        return window->KeyIsPressed(key);
+        return Application::Get().GetInputState().IsKeyDown(key);
     }
 
     bool Input::MouseIsPressed(MouseCode button)
     {
-        WindowsWindow* window = (WindowsWindow*)&Application::Get().GetWindow();
-        return window->MouseIsPressed(button);
+        return Application::Get().GetInputState().IsMouseDown(button);
     }
 
     int32 Input::GetMouseX()
     {
-        return Application::Get().GetWindow().GetMouseX();
+        return Application::Get().GetInputState().GetMouseX();
     }
 
     int32 Input::GetMouseY()
     {
-        return Application::Get().GetWindow().GetMouseY();
+        return Application::Get().GetInputState().GetMouseY();
+    }
+
+    bool Input::WasKeyPressed(KeyCode key)
+    {
+        return Application::Get().GetInputState().WasKeyPressed(key);
+    }
+
+    bool Input::WasKeyReleased(KeyCode key)
+    {
+        return Application::Get().GetInputState().WasKeyReleased(key);
+    }
+
+    bool Input::WasMousePressed(MouseCode button)
+    {
+        return Application::Get().GetInputState().WasMousePressed(button);
+    }
+
+    bool Input::WasMouseReleased(MouseCode button)
+    {
+        return Application::Get().GetInputState().WasMouseReleased(button);
     }
 }
\ No newline at end of file
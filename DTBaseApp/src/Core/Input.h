@@ -3,7 +3,7 @@
 
 namespace DT
 {
-	/* platform independent user input system */
+	/* platform independent user input system, answered from the application's per frame InputState */
 	class Input
 	{
 	public:
@@ -11,5 +11,11 @@ namespace DT
 		static bool MouseIsPressed(MouseCode button);
 		static int32 GetMouseX();
 		static int32 GetMouseY();
+
+		/* edges of the current frame */
+		static bool WasKeyPressed(KeyCode key);
+		static bool WasKeyReleased(KeyCode key);
+		static bool WasMousePressed(MouseCode button);
+		static bool WasMouseReleased(MouseCode button);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "InputState.h"
+
+namespace DT
+{
+	void InputState::BeginFrame()
+	{
+		m_PreviousKeysDown = m_KeysDown;
+		m_KeysPressed.reset();
+		m_KeysReleased.reset();
+		m_KeysRepeated.reset();
+
+		m_PreviousButtonsDown = m_ButtonsDown;
+		m_ButtonsPressed.reset();
+		m_ButtonsReleased.reset();
+
+		m_PreviousMouseX = m_MouseX;
+		m_PreviousMouseY = m_MouseY;
+		m_ScrollX = 0.0f;
+		m_ScrollY = 0.0f;
+		m_RawMouseDeltaX = 0.0f;
+		m_RawMouseDeltaY = 0.0f;
+	}
+
+	void InputState::OnEvent(const Event& event)
+	{
+		switch (event.GetType())
+		{
+			case Event::Type::KeyPressed:
+			{
+				const KeyPressedEvent& e = static_cast<const KeyPressedEvent&>(event);
+				size_t key = size_t(e.GetKeyCode());
+				if (key >= KeyCount)
+					break;
+
+				if (m_KeysDown[key])
+					m_KeysRepeated[key] = true;
+				else
+					m_KeysPressed[key] = true;
+				m_KeysDown[key] = true;
+				break;
+			}
+			case Event::Type::KeyReleased:
+			{
+				size_t key = size_t(static_cast<const KeyReleasedEvent&>(event).GetKeyCode());
+				if (key >= KeyCount)
+					break;
+
+				/* ReleaseAll on focus loss may already have set the edge, GLFW then sends the releases */
+				if (m_KeysDown[key])
+					m_KeysReleased[key] = true;
+				m_KeysDown[key] = false;
+				break;
+			}
+			case Event::Type::MouseButtonPressed:
+			{
+				size_t button = size_t(static_cast<const MouseButtonPressedEvent&>(event).GetButtonCode());
+				if (button >= MouseButtonCount)
+					break;
+
+				if (!m_ButtonsDown[button])
+					m_ButtonsPressed[button] = true;
+				m_ButtonsDown[button] = true;
+				break;
+			}
+			case Event::Type::MouseButtonReleased:
+			{
+				size_t button = size_t(static_cast<const MouseButtonReleasedEvent&>(event).GetButtonCode());
+				if (button >= MouseButtonCount)
+					break;
+
+				if (m_ButtonsDown[button])
+					m_ButtonsReleased[button] = true;
+				m_ButtonsDown[button] = false;
+				break;
+			}
+			case Event::Type::MouseMoved:
+			{
+				const MouseMovedEvent& e = static_cast<const MouseMovedEvent&>(event);
+				m_MouseX = e.GetX();
+				m_MouseY = e.GetY();
+				break;
+			}
+			case Event::Type::MouseScrolled:
+			{
+				const MouseScrolledEvent& e = static_cast<const MouseScrolledEvent&>(event);
+				m_ScrollX += e.GetDeltaX();
+				m_ScrollY += e.GetDeltaY();
+				break;
+			}
+			case Event::Type::MouseRawInput:
+			{
+				const MouseRawInputEvent& e = static_cast<const MouseRawInputEvent&>(event);
+				m_RawMouseDeltaX += e.GetDeltaX();
+				m_RawMouseDeltaY += e.GetDeltaY();
+				break;
+			}
+			case Event::Type::WindowFocus:
+			{
+				if (!static_cast<const WindowFocusEvent&>(event).IsFocused())
+					ReleaseAll();
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	void InputState::SetMousePosition(int32 x, int32 y)
+	{
+		m_MouseX = m_PreviousMouseX = x;
+		m_MouseY = m_PreviousMouseY = y;
+	}
+
+	void InputState::ReleaseAll()
+	{
+		m_KeysReleased |= m_KeysDown;
+		m_KeysDown.reset();
+		m_ButtonsReleased |= m_ButtonsDown;
+		m_ButtonsDown.reset();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+#include "Event.h"
+#include <bitset>
+
+namespace DT
+{
+	/*
+		per frame input snapshot built from the event stream: one bitset per attribute, so every
+		query is a single bit test and never reaches the platform layer
+	*/
+	class InputState
+	{
+	public:
+		static constexpr size_t KeyCount = 512u;        // covers every Key:: code
+		static constexpr size_t MouseButtonCount = 8u;  // Mouse::Button1 to Mouse::Button8
+	public:
+		/* start of a frame: keeps the current state as the previous one and clears the edges and per frame deltas */
+		void BeginFrame();
+		void OnEvent(const Event& event);
+		void SetMousePosition(int32 x, int32 y);
+
+		bool IsKeyDown(KeyCode key) const { return key < KeyCount && m_KeysDown[key]; }
+		bool WasKeyDown(KeyCode key) const { return key < KeyCount && m_PreviousKeysDown[key]; } // at the end of the previous frame
+		bool WasKeyPressed(KeyCode key) const { return key < KeyCount && m_KeysPressed[key]; }   // this frame, repeats excluded
+		bool WasKeyReleased(KeyCode key) const { return key < KeyCount && m_KeysReleased[key]; } // this frame
+		bool WasKeyRepeated(KeyCode key) const { return key < KeyCount && m_KeysRepeated[key]; } // this frame
+
+		bool IsMouseDown(MouseCode button) const { return button < MouseButtonCount && m_ButtonsDown[button]; }
+		bool WasMouseDown(MouseCode button) const { return button < MouseButtonCount && m_PreviousButtonsDown[button]; }
+		bool WasMousePressed(MouseCode button) const { return button < MouseButtonCount && m_ButtonsPressed[button]; }
+		bool WasMouseReleased(MouseCode button) const { return button < MouseButtonCount && m_ButtonsReleased[button]; }
+
+		int32 GetMouseX() const { return m_MouseX; }
+		int32 GetMouseY() const { return m_MouseY; }
+		int32 GetMouseDeltaX() const { return m_MouseX - m_PreviousMouseX; }
+		int32 GetMouseDeltaY() const { return m_MouseY - m_PreviousMouseY; }
+		float GetScrollX() const { return m_ScrollX; } // accumulated this frame
+		float GetScrollY() const { return m_ScrollY; }
+		float GetRawMouseDeltaX() const { return m_RawMouseDeltaX; } // summed MouseRawInputEvents of this frame
+		float GetRawMouseDeltaY() const { return m_RawMouseDeltaY; }
+
+		const std::bitset<KeyCount>& GetKeysDown() const { return m_KeysDown; }
+	private:
+		/* focus loss: the window will not report the releases, end every press now */
+		void ReleaseAll();
+	private:
+		std::bitset<KeyCount> m_KeysDown;
+		std::bitset<KeyCount> m_PreviousKeysDown;
+		std::bitset<KeyCount> m_KeysPressed;
+		std::bitset<KeyCount> m_KeysReleased;
+		std::bitset<KeyCount> m_KeysRepeated;
+
+		std::bitset<MouseButtonCount> m_ButtonsDown;
+		std::bitset<MouseButtonCount> m_PreviousButtonsDown;
+		std::bitset<MouseButtonCount> m_ButtonsPressed;
+		std::bitset<MouseButtonCount> m_ButtonsReleased;
+
+		int32 m_MouseX = 0;
+		int32 m_MouseY = 0;
+		int32 m_PreviousMouseX = 0;
+		int32 m_PreviousMouseY = 0;
+		float m_ScrollX = 0.0f;
+		float m_ScrollY = 0.0f;
+		float m_RawMouseDeltaX = 0.0f;
+		float m_RawMouseDeltaY = 0.0f;
+	};
+}
\ No newline at end of file
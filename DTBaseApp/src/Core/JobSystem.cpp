@@ -0,0 +1,201 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <array>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace DT
+{
+	static constexpr uint32 s_QueueCapacity = 1024u;
+	static constexpr uint32 s_NoThreadIndex = ~0u;
+
+	/* bounded deque: the owner works LIFO at the back, thieves take the oldest jobs from the front */
+	class alignas(64) WorkQueue
+	{
+	public:
+		bool PushBack(const Job& job)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (m_Count == s_QueueCapacity)
+				return false;
+
+			m_Jobs[(m_Front + m_Count) % s_QueueCapacity] = job;
+			m_Count++;
+			return true;
+		}
+
+		bool PopBack(Job& job)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (m_Count == 0u)
+				return false;
+
+			m_Count--;
+			job = m_Jobs[(m_Front + m_Count) % s_QueueCapacity];
+			return true;
+		}
+
+		bool PopFront(Job& job)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (m_Count == 0u)
+				return false;
+
+			job = m_Jobs[m_Front];
+			m_Front = (m_Front + 1u) % s_QueueCapacity;
+			m_Count--;
+			return true;
+		}
+	private:
+		std::mutex m_Mutex;
+		std::array<Job, s_QueueCapacity> m_Jobs;
+		uint32 m_Front = 0u;
+		uint32 m_Count = 0u;
+	};
+
+	struct JobSystemState
+	{
+		std::vector<std::thread> Workers;
+		std::unique_ptr<WorkQueue[]> Queues; // [0] is the main thread, [i] is worker i
+		uint32 QueueCount = 0u;
+
+		std::atomic<uint32> QueuedJobs = 0u;
+		std::atomic<uint32> SleepingWorkers = 0u;
+		std::atomic<uint32> NextForeignQueue = 0u;
+		std::atomic<bool> Running = false;
+
+		std::mutex SleepMutex;
+		std::condition_variable WakeCondition;
+	};
+
+	static JobSystemState* s_State = nullptr;
+	static thread_local uint32 s_ThreadIndex = s_NoThreadIndex;
+
+	void JobSystem::Init(uint32 workerCount)
+	{
+		if (workerCount == 0u)
+			workerCount = std::max(std::thread::hardware_concurrency(), 1u) - 1u;
+
+		s_State = new JobSystemState;
+		s_State->QueueCount = workerCount + 1u;
+		s_State->Queues = std::make_unique<WorkQueue[]>(s_State->QueueCount);
+		s_State->Running = true;
+
+		s_ThreadIndex = 0u;
+		for (uint32 i = 1u; i <= workerCount; i++)
+			s_State->Workers.emplace_back(&JobSystem::WorkerMain, i);
+
+		LOG_TRACE("Job system started with {} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!s_State)
+			return;
+
+		s_State->Running = false;
+		{
+			std::lock_guard<std::mutex> lock(s_State->SleepMutex);
+		}
+		s_State->WakeCondition.notify_all();
+
+		for (std::thread& worker : s_State->Workers)
+			worker.join();
+
+		delete s_State;
+		s_State = nullptr;
+		s_ThreadIndex = s_NoThreadIndex;
+	}
+
+	uint32 JobSystem::GetWorkerCount()
+	{
+		return s_State ? s_State->QueueCount - 1u : 0u;
+	}
+
+	void JobSystem::Submit(const Job& job)
+	{
+		if (job.Counter)
+			job.Counter->m_Pending.fetch_add(1u, std::memory_order_relaxed);
+
+		if (!s_State)
+		{
+			Execute(job);
+			return;
+		}
+
+		uint32 queue = s_ThreadIndex;
+		if (queue == s_NoThreadIndex)
+			queue = s_State->NextForeignQueue.fetch_add(1u, std::memory_order_relaxed) % s_State->QueueCount;
+
+		s_State->QueuedJobs++;
+		if (!s_State->Queues[queue].PushBack(job))
+		{
+			s_State->QueuedJobs--;
+			Execute(job);
+			return;
+		}
+
+		if (s_State->SleepingWorkers > 0u)
+		{
+			{
+				std::lock_guard<std::mutex> lock(s_State->SleepMutex);
+			}
+			s_State->WakeCondition.notify_one();
+		}
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!s_State || !ExecuteNext())
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::Execute(const Job& job)
+	{
+		job.Function(job.UserData, job.Begin, job.End);
+
+		if (job.Counter)
+			job.Counter->m_Pending.fetch_sub(1u, std::memory_order_release);
+	}
+
+	bool JobSystem::ExecuteNext()
+	{
+		Job job;
+		uint32 self = s_ThreadIndex == s_NoThreadIndex ? 0u : s_ThreadIndex;
+
+		bool found = s_ThreadIndex != s_NoThreadIndex && s_State->Queues[self].PopBack(job);
+		for (uint32 i = 1u; !found && i <= s_State->QueueCount; i++)
+			found = s_State->Queues[(self + i) % s_State->QueueCount].PopFront(job);
+
+		if (!found)
+			return false;
+
+		s_State->QueuedJobs--;
+		Execute(job);
+		return true;
+	}
+
+	void JobSystem::WorkerMain(uint32 threadIndex)
+	{
+		s_ThreadIndex = threadIndex;
+		PROFILE_THREAD_NAME(Profiler::InternString(std::format("Worker {}", threadIndex)));
+
+		while (s_State->Running)
+		{
+			if (ExecuteNext())
+				continue;
+
+			std::unique_lock<std::mutex> lock(s_State->SleepMutex);
+			s_State->SleepingWorkers++;
+			s_State->WakeCondition.wait(lock, []
+			{
+				return s_State->QueuedJobs > 0u || !s_State->Running;
+			});
+			s_State->SleepingWorkers--;
+		}
+	}
+}
\ No newline at end of file
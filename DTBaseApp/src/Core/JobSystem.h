@@ -0,0 +1,82 @@
+#pragma once
+#include "Core.h"
+#include <atomic>
+
+namespace DT
+{
+	/* number of unfinished jobs, JobSystem::Wait() executes jobs until it drops to zero */
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator = (const JobCounter&) = delete;
+
+		bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0u; }
+	private:
+		std::atomic<uint32> m_Pending = 0u;
+
+		friend class JobSystem;
+	};
+
+	struct Job
+	{
+		void (*Function)(void* userData, uint32 begin, uint32 end) = nullptr;
+		void* UserData = nullptr;
+		uint32 Begin = 0u;
+		uint32 End = 0u;
+		JobCounter* Counter = nullptr;
+	};
+
+	/* work stealing thread pool: every thread owns a deque, idle threads steal from the others */
+	class JobSystem
+	{
+	public:
+		/* workerCount = 0 uses one worker per hardware thread besides the main thread */
+		static void Init(uint32 workerCount = 0u);
+		static void Shutdown();
+
+		static uint32 GetWorkerCount();
+
+		/* safe to call from any thread, including from inside a job */
+		static void Submit(const Job& job);
+
+		/* runs queued jobs on the calling thread until the counter is done */
+		static void Wait(JobCounter& counter);
+
+		/* calls fn(begin, end) over [0, count) in chunks of grainSize and waits for all of them */
+		template<typename Fn>
+		static void ParallelFor(uint32 count, uint32 grainSize, Fn&& fn)
+		{
+			if (count == 0u)
+				return;
+
+			grainSize = std::max(grainSize, 1u);
+			if (GetWorkerCount() == 0u || count <= grainSize)
+			{
+				fn(0u, count);
+				return;
+			}
+
+			using Callable = std::remove_reference_t<Fn>;
+			void* userData = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+
+			JobCounter counter;
+			for (uint32 begin = grainSize; begin < count; begin += grainSize)
+				Submit({ &InvokeRange<Callable>, userData, begin, std::min(begin + grainSize, count), &counter });
+
+			fn(0u, grainSize);
+			Wait(counter);
+		}
+	private:
+		static void Execute(const Job& job);
+		static bool ExecuteNext();
+		static void WorkerMain(uint32 threadIndex);
+
+		template<typename Callable>
+		static void InvokeRange(void* userData, uint32 begin, uint32 end)
+		{
+			(*static_cast<Callable*>(userData))(begin, end);
+		}
+	};
+}
\ No newline at end of file
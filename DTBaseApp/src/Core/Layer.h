@@ -1,19 +1,77 @@
 #pragma once
 #include "Core.h"
 #include "Event.h"
+#include "FramePacket.h"
 
 namespace DT
 {
 	class Layer
 	{
 	public:
-		Layer() = default;
+		Layer(const std::string& name = "Layer")
+			: m_Name(name) {}
 		virtual ~Layer() = default;
 
 		virtual void OnAttach() {}
 		virtual void OnDetach() {}
 		virtual void OnUpdate(float dt) {}
-		virtual void OnRender() {}
+		/* main thread, after the update phase: copy what OnRender needs into the packet */
+		virtual void OnPrepareRender(FramePacket& packet) {}
+		/* may run on the render thread concurrently with the next OnUpdate: only read the packet */
+		virtual void OnRender(const FramePacket& packet) {}
 		virtual void OnEvent(Event& event) {}
+
+		bool IsInterestedIn(Event::Type type) const
+		{
+			return (m_EventTypeMask & EventTypeBit(type)) || (m_EventCategories & EventTypeCategories[size_t(type)]);
+		}
+		uint64 GetDispatchCount() const { return m_DispatchCount; }
+		const std::string& GetName() const { return m_Name; }
+
+		bool HasParallelUpdate() const { return m_ParallelUpdate; }
+		const std::vector<Layer*>& GetUpdateDependencies() const { return m_UpdateDependencies; }
+
+		/* "<name>::OnUpdate" etc, interned by Application::PushLayer so they outlive the layer */
+		struct ProfileZoneNames
+		{
+			const char* OnUpdate = "Layer::OnUpdate";
+			const char* OnRender = "Layer::OnRender";
+			const char* OnEvent  = "Layer::OnEvent";
+		};
+		const ProfileZoneNames& GetProfileZoneNames() const { return m_ProfileZoneNames; }
+
+		/* FrameStatistics series of this layer, registered by Application::PushLayer */
+		struct StatisticSeries
+		{
+			uint32 OnUpdate = ~0u;
+			uint32 OnRender = ~0u;
+		};
+		const StatisticSeries& GetStatisticSeries() const { return m_StatisticSeries; }
+	protected:
+		/* OnEvent only receives events matching a category or a type bit, read when the layer is pushed */
+		void SetEventInterest(int32 categories, uint64 typeMask = 0u)
+		{
+			m_EventCategories = categories;
+			m_EventTypeMask = typeMask;
+		}
+
+		/* OnUpdate runs as a job on the JobSystem, concurrently with the other parallel layers */
+		void SetParallelUpdate(bool parallel) { m_ParallelUpdate = parallel; }
+
+		/* a parallel OnUpdate starts only after the OnUpdate of every dependency has finished */
+		void AddUpdateDependency(Layer* dependency) { m_UpdateDependencies.emplace_back(dependency); }
+	private:
+		std::string m_Name;
+		ProfileZoneNames m_ProfileZoneNames;
+		StatisticSeries m_StatisticSeries;
+
+		int32 m_EventCategories = ~Event::CategoryNone;
+		uint64 m_EventTypeMask = 0u;
+		uint64 m_DispatchCount = 0u;
+
+		bool m_ParallelUpdate = false;
+		std::vector<Layer*> m_UpdateDependencies;
+
+		friend class Application;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "LayerUpdateGraph.h"
+#include "Profiler.h"
+
+namespace DT
+{
+	static constexpr uint32 s_NotInGraph = ~0u;
+
+	void LayerUpdateGraph::Build(const std::vector<Layer*>& layers, std::vector<Layer*>& serialLayers)
+	{
+		serialLayers.clear();
+		std::vector<Layer*> parallelLayers;
+		for (Layer* layer : layers)
+		{
+			if (layer->HasParallelUpdate())
+				parallelLayers.emplace_back(layer);
+			else
+				serialLayers.emplace_back(layer);
+		}
+
+		auto indexOf = [&](Layer* layer)
+		{
+			auto it = std::find(parallelLayers.begin(), parallelLayers.end(), layer);
+			return it == parallelLayers.end() ? s_NotInGraph : uint32(it - parallelLayers.begin());
+		};
+
+		/* Kahn's algorithm: whatever is never reached sits on a dependency cycle */
+		std::vector<std::vector<uint32>> dependents(parallelLayers.size());
+		std::vector<uint32> remaining(parallelLayers.size(), 0u);
+		for (uint32 i = 0u; i < parallelLayers.size(); i++)
+		{
+			for (Layer* dependency : parallelLayers[i]->GetUpdateDependencies())
+			{
+				uint32 j = indexOf(dependency);
+				if (j == s_NotInGraph || j == i)
+					continue;
+
+				dependents[j].emplace_back(i);
+				remaining[i]++;
+			}
+		}
+
+		std::vector<uint32> ready;
+		for (uint32 i = 0u; i < parallelLayers.size(); i++)
+		{
+			if (remaining[i] == 0u)
+				ready.emplace_back(i);
+		}
+
+		std::vector<bool> acyclic(parallelLayers.size(), false);
+		while (!ready.empty())
+		{
+			uint32 i = ready.back();
+			ready.pop_back();
+			acyclic[i] = true;
+
+			for (uint32 dependent : dependents[i])
+			{
+				if (--remaining[dependent] == 0u)
+					ready.emplace_back(dependent);
+			}
+		}
+
+		std::vector<uint32> nodeIndices(parallelLayers.size(), s_NotInGraph);
+		uint32 nodeCount = 0u;
+		for (uint32 i = 0u; i < parallelLayers.size(); i++)
+		{
+			if (acyclic[i])
+			{
+				nodeIndices[i] = nodeCount++;
+			}
+			else
+			{
+				LOG_ERROR("Layer update dependencies form a cycle, updating one of its layers serially");
+				serialLayers.emplace_back(parallelLayers[i]);
+			}
+		}
+
+		m_Nodes = std::vector<Node>(nodeCount);
+		m_Roots.clear();
+		for (uint32 i = 0u; i < parallelLayers.size(); i++)
+		{
+			if (!acyclic[i])
+				continue;
+
+			Node& node = m_Nodes[nodeIndices[i]];
+			node.Owner = parallelLayers[i];
+			node.Graph = this;
+			for (uint32 dependent : dependents[i])
+			{
+				if (!acyclic[dependent])
+					continue;
+
+				node.Dependents.emplace_back(nodeIndices[dependent]);
+				m_Nodes[nodeIndices[dependent]].DependencyCount++;
+			}
+		}
+
+		for (uint32 i = 0u; i < nodeCount; i++)
+		{
+			if (m_Nodes[i].DependencyCount == 0u)
+				m_Roots.emplace_back(i);
+		}
+	}
+
+	void LayerUpdateGraph::Run(float dt, FrameStatistics& statistics)
+	{
+		m_DeltaTime = dt;
+		m_Statistics = &statistics;
+		for (Node& node : m_Nodes)
+			node.PendingDependencies.store(node.DependencyCount, std::memory_order_relaxed);
+
+		for (uint32 root : m_Roots)
+			JobSystem::Submit({ &UpdateLayerJob, &m_Nodes[root], 0u, 0u, &m_Counter });
+
+		JobSystem::Wait(m_Counter);
+	}
+
+	void LayerUpdateGraph::UpdateLayerJob(void* userData, uint32 begin, uint32 end)
+	{
+		Node& node = *static_cast<Node*>(userData);
+		LayerUpdateGraph& graph = *node.Graph;
+
+		{
+			PROFILE_SCOPE(node.Owner->GetProfileZoneNames().OnUpdate);
+			FrameStatistics::Scope statistic(*graph.m_Statistics, node.Owner->GetStatisticSeries().OnUpdate);
+			node.Owner->OnUpdate(graph.m_DeltaTime);
+		}
+
+		for (uint32 dependent : node.Dependents)
+		{
+			if (graph.m_Nodes[dependent].PendingDependencies.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+				JobSystem::Submit({ &UpdateLayerJob, &graph.m_Nodes[dependent], 0u, 0u, &graph.m_Counter });
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include "Layer.h"
+#include "JobSystem.h"
+#include "FrameStatistics.h"
+
+namespace DT
+{
+	/* schedules the OnUpdate of parallel layers as jobs, honoring their declared dependencies */
+	class LayerUpdateGraph
+	{
+	public:
+		/* layers that are not parallel, or that take part in a dependency cycle, are returned in serialLayers */
+		void Build(const std::vector<Layer*>& layers, std::vector<Layer*>& serialLayers);
+		void Run(float dt, FrameStatistics& statistics);
+
+		bool IsEmpty() const { return m_Nodes.empty(); }
+	private:
+		struct Node
+		{
+			Layer* Owner = nullptr;
+			LayerUpdateGraph* Graph = nullptr;
+			std::vector<uint32> Dependents;
+			uint32 DependencyCount = 0u;
+			std::atomic<uint32> PendingDependencies = 0u;
+		};
+
+		static void UpdateLayerJob(void* userData, uint32 begin, uint32 end);
+	private:
+		std::vector<Node> m_Nodes;
+		std::vector<uint32> m_Roots;
+		JobCounter m_Counter;
+		float m_DeltaTime = 0.0f;
+		FrameStatistics* m_Statistics = nullptr;
+	};
+}
\ No newline at end of file
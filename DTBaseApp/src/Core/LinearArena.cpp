@@ -0,0 +1,74 @@
+#include "LinearArena.h"
+
+namespace DT
+{
+	LinearArena::LinearArena(size_t initialCapacity)
+	{
+		m_Current = AddBlock(std::max<size_t>(initialCapacity, 1024u));
+	}
+
+	void* LinearArena::Allocate(size_t size, size_t alignment)
+	{
+		/* reserve the worst case padding so the aligned range fits whatever the offset */
+		size_t reserved = size + alignment - 1u;
+
+		while (true)
+		{
+			Block* block = m_Current.load(std::memory_order_acquire);
+			size_t offset = block->Used.fetch_add(reserved, std::memory_order_relaxed);
+			if (offset + reserved <= block->Size)
+			{
+				uintptr_t address = uintptr_t(block->Memory.get() + offset);
+				return (void*)((address + alignment - 1u) & ~uintptr_t(alignment - 1u));
+			}
+
+			std::lock_guard<std::mutex> lock(m_GrowMutex);
+			if (m_Current.load(std::memory_order_relaxed) == block)
+			{
+				m_OverflowCount.fetch_add(1u, std::memory_order_relaxed);
+				m_Current.store(AddBlock(std::max(block->Size * 2u, reserved)), std::memory_order_release);
+			}
+		}
+	}
+
+	void LinearArena::Reset()
+	{
+		size_t used = 0u;
+		size_t capacity = 0u;
+		for (std::unique_ptr<Block>& block : m_Blocks)
+		{
+			used += std::min(block->Used.load(std::memory_order_relaxed), block->Size);
+			capacity += block->Size;
+		}
+		m_HighWaterMark = std::max(m_HighWaterMark, used);
+
+		if (m_Blocks.size() > 1u)
+		{
+			m_Blocks.clear();
+			m_Current = AddBlock(capacity);
+		}
+		m_Current.load(std::memory_order_relaxed)->Used.store(0u, std::memory_order_relaxed);
+	}
+
+	LinearArena::Statistics LinearArena::GetStatistics() const
+	{
+		Statistics statistics;
+		for (const std::unique_ptr<Block>& block : m_Blocks)
+		{
+			statistics.Used += std::min(block->Used.load(std::memory_order_relaxed), block->Size);
+			statistics.Capacity += block->Size;
+		}
+		statistics.HighWaterMark = std::max(m_HighWaterMark, statistics.Used);
+		statistics.BlockCount = (uint32)m_Blocks.size();
+		statistics.OverflowCount = m_OverflowCount.load(std::memory_order_relaxed);
+		return statistics;
+	}
+
+	LinearArena::Block* LinearArena::AddBlock(size_t size)
+	{
+		std::unique_ptr<Block>& block = m_Blocks.emplace_back(std::make_unique<Block>());
+		block->Memory = std::make_unique_for_overwrite<std::byte[]>(size);
+		block->Size = size;
+		return block.get();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+#include "Core.h"
+#include <atomic>
+#include <mutex>
+
+namespace DT
+{
+	/*
+		bump allocator for data that lives until the next Reset: Allocate is a single atomic add
+		and is safe from any thread, Reset must not race with it. Nothing is destroyed on Reset,
+		only put trivially destructible data or objects whose destructor is not needed in it
+	*/
+	class LinearArena
+	{
+	public:
+		struct Statistics
+		{
+			size_t Used = 0u;          // bytes handed out since the last Reset, alignment padding included
+			size_t Capacity = 0u;      // bytes reserved by all blocks
+			size_t HighWaterMark = 0u; // largest Used seen at a Reset
+			uint32 BlockCount = 0u;
+			uint64 OverflowCount = 0u; // times a block ran out and a new one was allocated
+		};
+	public:
+		LinearArena(size_t initialCapacity = 64u * 1024u);
+
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator = (const LinearArena&) = delete;
+
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		template<typename T, typename... Args>
+		T* New(Args&&... args)
+		{
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		T* NewArray(size_t count)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "arena arrays are never destroyed");
+			T* data = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+			for (size_t i = 0u; i < count; i++)
+				new (data + i) T();
+			return data;
+		}
+
+		/* frees everything at once; if the last frame overflowed, the blocks are merged into one big enough for it */
+		void Reset();
+
+		Statistics GetStatistics() const;
+	private:
+		struct Block
+		{
+			std::unique_ptr<std::byte[]> Memory;
+			size_t Size = 0u;
+			std::atomic<size_t> Used = 0u;
+		};
+
+		Block* AddBlock(size_t size);
+	private:
+		std::atomic<Block*> m_Current = nullptr;
+		std::vector<std::unique_ptr<Block>> m_Blocks;
+		std::mutex m_GrowMutex;
+
+		size_t m_HighWaterMark = 0u;
+		std::atomic<uint64> m_OverflowCount = 0u;
+	};
+
+	/* std allocator over a LinearArena, deallocate is a no-op */
+	template<typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		ArenaAllocator(LinearArena& arena)
+			: m_Arena(&arena) {}
+
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other)
+			: m_Arena(other.GetArena()) {}
+
+		T* allocate(size_t count) { return static_cast<T*>(m_Arena->Allocate(sizeof(T) * count, alignof(T))); }
+		void deallocate(T*, size_t) {}
+
+		LinearArena* GetArena() const { return m_Arena; }
+
+		template<typename U>
+		bool operator == (const ArenaAllocator<U>& other) const { return m_Arena == other.GetArena(); }
+	private:
+		LinearArena* m_Arena;
+	};
+
+	template<typename T>
+	using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
\ No newline at end of file
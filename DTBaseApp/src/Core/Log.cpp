@@ -1,18 +1,42 @@
-#include "Log.h"
+#include "Core.h"
+#include "AsyncLogger.h"
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 namespace DT
 {
-	void Log::Init()
+	static std::shared_ptr<AsyncLogger> s_AsyncLogger;
+
+	void Log::Init(const LogSpecification& specification)
 	{
 		spdlog::set_pattern("%^[%T] %v%$");
 
-		s_DefaultLogger = spdlog::stdout_color_mt("DTCoreApp");
+		spdlog::sink_ptr sink = specification.Sink ? specification.Sink : std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+
+		if (specification.Mode == LogMode::Asynchronous)
+		{
+			/* single flusher thread: messages keep their order */
+			s_AsyncLogger = std::make_shared<AsyncLogger>("DTCoreApp", sink, specification.QueueSize, specification.OverflowPolicy);
+			s_DefaultLogger = s_AsyncLogger;
+		}
+		else
+		{
+			s_AsyncLogger.reset();
+			s_DefaultLogger = std::make_shared<spdlog::logger>("DTCoreApp", sink);
+		}
+		spdlog::initialize_logger(s_DefaultLogger);
 		s_DefaultLogger->set_level(spdlog::level::trace);
 	}
 
 	void Log::Shutdown()
 	{
+		/* messages logged after this are written by the calling thread */
+		if (s_AsyncLogger)
+			s_AsyncLogger->Stop();
 		spdlog::shutdown();
 	}
-}
\ No newline at end of file
+
+	uint64 Log::GetDroppedMessageCount()
+	{
+		return s_AsyncLogger ? s_AsyncLogger->GetDroppedMessageCount() : 0u;
+	}
+}
@@ -1,20 +1,50 @@
 #pragma once
 #include "spdlog/spdlog.h"
+#include "BinaryLog.h"
 
 namespace DT
 {
+	enum class LogMode
+	{
+		Synchronous, // the calling thread formats and writes the message
+		Asynchronous // the calling thread formats the arguments into a lock-free ring, a background thread writes
+	};
+
+	enum class LogOverflowPolicy
+	{
+		Block,     // callers wait for a free slot, nothing is lost
+		DropOldest // the oldest queued message is overwritten and counted as dropped
+	};
+
+	struct LogSpecification
+	{
+		LogMode Mode                     = LogMode::Synchronous;
+		uint32 QueueSize                 = 8192u; // preallocated message slots (rounded up to a power of two), asynchronous mode only
+		LogOverflowPolicy OverflowPolicy = LogOverflowPolicy::Block;
+		std::filesystem::path BinaryLogPath = "DTBaseApp.dtlog"; // DT_ENABLE_BINARY_LOGGING only, decode with Tools/LogDecoder
+		spdlog::sink_ptr Sink;                                   // nullptr = colored stdout
+	};
+
 	class Log
 	{
 	public:
-		static void Init();
+		static void Init(const LogSpecification& specification = {});
 		static void Shutdown();
 
+		static uint64 GetDroppedMessageCount();
+
 		static std::shared_ptr<spdlog::logger>& GetDefaultLogger() { return s_DefaultLogger; }
 	private:
 		inline static std::shared_ptr<spdlog::logger> s_DefaultLogger;
 	};
 
-#if DT_ENABLE_LOGGING
+#if DT_ENABLE_LOGGING && DT_ENABLE_BINARY_LOGGING
+	#define LOG_TRACE(...)    DT_BINARY_LOG(::DT::BinaryLogFormat::Level::Trace, __VA_ARGS__)
+	#define LOG_INFO(...)     DT_BINARY_LOG(::DT::BinaryLogFormat::Level::Info, __VA_ARGS__)
+	#define LOG_WARN(...)     DT_BINARY_LOG(::DT::BinaryLogFormat::Level::Warn, __VA_ARGS__)
+	#define LOG_ERROR(...)    DT_BINARY_LOG(::DT::BinaryLogFormat::Level::Error, __VA_ARGS__)
+	#define LOG_CRITICAL(...) DT_BINARY_LOG(::DT::BinaryLogFormat::Level::Critical, __VA_ARGS__)
+#elif DT_ENABLE_LOGGING
 	#define LOG_TRACE(...)    ::DT::Log::GetDefaultLogger()->trace(__VA_ARGS__)
 	#define LOG_INFO(...)     ::DT::Log::GetDefaultLogger()->info(__VA_ARGS__)
 	#define LOG_WARN(...)     ::DT::Log::GetDefaultLogger()->warn(__VA_ARGS__)
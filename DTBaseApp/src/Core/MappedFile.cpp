@@ -0,0 +1,183 @@
+#include "MappedFile.h"
+
+#if DT_PLATFORM_WINDOWS
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace DT
+{
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const std::filesystem::path& filePath, MappedFileAccess access, uint64 size)
+	{
+		Close();
+		m_Access = access;
+		bool readOnly = access != MappedFileAccess::ReadWrite; // the file itself
+
+	#if DT_PLATFORM_WINDOWS
+		HANDLE file = CreateFileW(filePath.c_str(), readOnly ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+			readOnly ? OPEN_EXISTING : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+		m_FileHandle = file;
+
+		if (readOnly)
+		{
+			LARGE_INTEGER fileSize;
+			GetFileSizeEx(file, &fileSize);
+			size = (uint64)fileSize.QuadPart;
+		}
+	#else
+		int32 file = open(filePath.c_str(), readOnly ? O_RDONLY : O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (file < 0)
+			return false;
+		m_FileDescriptor = file;
+
+		if (readOnly)
+		{
+			struct stat status;
+			fstat(file, &status);
+			size = (uint64)status.st_size;
+		}
+	#endif
+
+		m_Size = size;
+		if (!readOnly && !Resize(size))
+		{
+			Close();
+			return false;
+		}
+		if (readOnly && size > 0u && !Map())
+		{
+			Close();
+			return false;
+		}
+
+	#if !DT_PLATFORM_WINDOWS
+		/* a mapping outlives its descriptor: files that never grow do not hold one, many can stay mapped */
+		if (readOnly)
+		{
+			close(m_FileDescriptor);
+			m_FileDescriptor = -1;
+		}
+	#endif
+		return true;
+	}
+
+	bool MappedFile::Resize(uint64 size)
+	{
+		ASSERT(m_Access == MappedFileAccess::ReadWrite);
+		Unmap();
+
+	#if DT_PLATFORM_WINDOWS
+		LARGE_INTEGER fileSize;
+		fileSize.QuadPart = (LONGLONG)size;
+		if (!SetFilePointerEx(m_FileHandle, fileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(m_FileHandle))
+			return false;
+	#else
+		if (ftruncate(m_FileDescriptor, (off_t)size) != 0)
+			return false;
+	#endif
+
+		m_Size = size;
+		return size == 0u || Map();
+	}
+
+	void MappedFile::Close(uint64 finalSize)
+	{
+		Unmap();
+
+	#if DT_PLATFORM_WINDOWS
+		if (m_FileHandle != nullptr)
+		{
+			if (m_Access == MappedFileAccess::ReadWrite && finalSize != ~0ull)
+			{
+				LARGE_INTEGER fileSize;
+				fileSize.QuadPart = (LONGLONG)finalSize;
+				SetFilePointerEx(m_FileHandle, fileSize, nullptr, FILE_BEGIN);
+				SetEndOfFile(m_FileHandle);
+			}
+			CloseHandle(m_FileHandle);
+			m_FileHandle = nullptr;
+		}
+	#else
+		if (m_FileDescriptor >= 0)
+		{
+			if (m_Access == MappedFileAccess::ReadWrite && finalSize != ~0ull)
+				(void)ftruncate(m_FileDescriptor, (off_t)finalSize);
+			close(m_FileDescriptor);
+			m_FileDescriptor = -1;
+		}
+	#endif
+
+		m_Size = 0u;
+	}
+
+	void MappedFile::Flush()
+	{
+		if (m_Data == nullptr || m_Access != MappedFileAccess::ReadWrite)
+			return;
+
+	#if DT_PLATFORM_WINDOWS
+		FlushViewOfFile(m_Data, 0u);
+	#else
+		msync(m_Data, m_Size, MS_ASYNC);
+	#endif
+	}
+
+	bool MappedFile::Map()
+	{
+	#if DT_PLATFORM_WINDOWS
+		DWORD protection = PAGE_READWRITE;
+		DWORD viewAccess = FILE_MAP_WRITE;
+		if (m_Access == MappedFileAccess::Read)
+		{
+			protection = PAGE_READONLY;
+			viewAccess = FILE_MAP_READ;
+		}
+		else if (m_Access == MappedFileAccess::CopyOnWrite)
+		{
+			protection = PAGE_WRITECOPY;
+			viewAccess = FILE_MAP_COPY;
+		}
+
+		m_MappingHandle = CreateFileMappingW(m_FileHandle, nullptr, protection, 0u, 0u, nullptr);
+		if (m_MappingHandle == nullptr)
+			return false;
+
+		m_Data = static_cast<std::byte*>(MapViewOfFile(m_MappingHandle, viewAccess, 0u, 0u, 0u));
+	#else
+		int protection = m_Access == MappedFileAccess::Read ? PROT_READ : PROT_READ | PROT_WRITE;
+		int flags = m_Access == MappedFileAccess::CopyOnWrite ? MAP_PRIVATE : MAP_SHARED;
+		void* data = mmap(nullptr, m_Size, protection, flags, m_FileDescriptor, 0);
+		m_Data = data == MAP_FAILED ? nullptr : static_cast<std::byte*>(data);
+	#endif
+
+		return m_Data != nullptr;
+	}
+
+	void MappedFile::Unmap()
+	{
+	#if DT_PLATFORM_WINDOWS
+		if (m_Data != nullptr)
+			UnmapViewOfFile(m_Data);
+		if (m_MappingHandle != nullptr)
+			CloseHandle(m_MappingHandle);
+		m_MappingHandle = nullptr;
+	#else
+		if (m_Data != nullptr)
+			munmap(m_Data, m_Size);
+	#endif
+		m_Data = nullptr;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include "Core.h"
+
+namespace DT
+{
+	enum class MappedFileAccess
+	{
+		Read,        // existing file, read only view
+		CopyOnWrite, // existing file, writable view whose changes stay private to the process
+		ReadWrite    // created or truncated, can grow with Resize
+	};
+
+	/* a whole file mapped into memory (file mapping on Windows, mmap elsewhere) */
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator = (const MappedFile&) = delete;
+
+		/* Read and CopyOnWrite map the existing file, ReadWrite creates the file with size bytes */
+		bool Open(const std::filesystem::path& filePath, MappedFileAccess access, uint64 size = 0u);
+		/* ReadWrite only: remaps the file with a new size, previous pointers into the data are invalidated */
+		bool Resize(uint64 size);
+		/* finalSize truncates a ReadWrite file before it is closed */
+		void Close(uint64 finalSize = ~0ull);
+		/* writes dirty pages back to the file */
+		void Flush();
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		std::byte* GetData() { return m_Data; }
+		const std::byte* GetData() const { return m_Data; }
+		uint64 GetSize() const { return m_Size; }
+	private:
+		bool Map();
+		void Unmap();
+	private:
+		std::byte* m_Data = nullptr;
+		uint64 m_Size = 0u;
+		MappedFileAccess m_Access = MappedFileAccess::Read;
+
+	#if DT_PLATFORM_WINDOWS
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+	#else
+		int32 m_FileDescriptor = -1;
+	#endif
+	};
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "Profiler.h"
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <unordered_set>
+
+namespace DT
+{
+	static constexpr uint32 s_ZonesPerThread = 1u << 16u;
+
+	struct ProfileZone
+	{
+		const char* Name;
+		uint64 Start;
+		uint64 End;
+	};
+
+	/*
+		written only by its thread, read by EndCapture up to the published count. State packs the capture
+		epoch (high 32 bits) with the zone count: the thread starts over when it sees a new epoch, so
+		BeginCapture never has to write another thread's count
+	*/
+	struct ProfileThreadBuffer
+	{
+		const char* Name = nullptr;
+		uint32 ThreadId = 0u;
+		std::unique_ptr<ProfileZone[]> Zones = std::make_unique<ProfileZone[]>(s_ZonesPerThread);
+		std::atomic<uint64> State = 0u;
+		std::atomic<uint32> Dropped = 0u;
+	};
+
+	struct ProfilerState
+	{
+		std::mutex Mutex;
+		std::vector<std::unique_ptr<ProfileThreadBuffer>> Threads;
+		std::unordered_set<std::string> InternedStrings;
+		std::filesystem::path CapturePath;
+		uint64 CaptureStart = 0u;
+	};
+
+	static std::unique_ptr<ProfilerState> s_State;
+	static std::atomic<bool> s_Capturing = false;
+	static std::atomic<uint32> s_CaptureEpoch = 0u;
+	static thread_local ProfileThreadBuffer* s_ThreadBuffer = nullptr;
+
+	static ProfileThreadBuffer& GetThreadBuffer()
+	{
+		if (s_ThreadBuffer == nullptr)
+		{
+			std::lock_guard<std::mutex> lock(s_State->Mutex);
+			std::unique_ptr<ProfileThreadBuffer>& buffer = s_State->Threads.emplace_back(std::make_unique<ProfileThreadBuffer>());
+			buffer->ThreadId = (uint32)s_State->Threads.size();
+			s_ThreadBuffer = buffer.get();
+		}
+		return *s_ThreadBuffer;
+	}
+
+	static void WriteEscaped(std::ofstream& file, const char* string)
+	{
+		for (; *string != '\0'; string++)
+		{
+			if (*string == '"' || *string == '\\')
+				file << '\\';
+			file << *string;
+		}
+	}
+
+	void Profiler::Init()
+	{
+		s_State = std::make_unique<ProfilerState>();
+		SetThreadName("Main");
+	}
+
+	void Profiler::Shutdown()
+	{
+		if (IsCapturing())
+			EndCapture();
+
+		/* buffers of threads that are still alive would dangle */
+		s_ThreadBuffer = nullptr;
+		s_State.reset();
+	}
+
+	void Profiler::BeginCapture(const std::filesystem::path& filePath)
+	{
+		ASSERT(s_State && !IsCapturing());
+
+		{
+			std::lock_guard<std::mutex> lock(s_State->Mutex);
+			s_State->CapturePath = filePath;
+			s_State->CaptureStart = Timer::Now();
+		}
+		s_CaptureEpoch.fetch_add(1u, std::memory_order_release);
+		s_Capturing.store(true, std::memory_order_release);
+	}
+
+	void Profiler::EndCapture()
+	{
+		ASSERT(IsCapturing());
+		s_Capturing.store(false, std::memory_order_release);
+
+		std::lock_guard<std::mutex> lock(s_State->Mutex);
+		std::ofstream file(s_State->CapturePath);
+		if (!file)
+		{
+			LOG_ERROR("Could not write profiler capture {}", s_State->CapturePath.string());
+			return;
+		}
+
+		uint64 zoneCount = 0u;
+		uint64 droppedCount = 0u;
+		bool first = true;
+		auto separator = [&file, &first]()
+		{
+			file << (first ? "\n" : ",\n");
+			first = false;
+		};
+
+		/* Chrome trace "complete" events, timestamps in microseconds from the capture start */
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		uint32 epoch = s_CaptureEpoch.load(std::memory_order_relaxed);
+		for (const std::unique_ptr<ProfileThreadBuffer>& buffer : s_State->Threads)
+		{
+			/* a thread that recorded nothing since BeginCapture still holds the previous capture */
+			uint64 state = buffer->State.load(std::memory_order_acquire);
+			bool current = uint32(state >> 32u) == epoch;
+			uint32 count = current ? std::min(uint32(state), s_ZonesPerThread) : 0u;
+			if (buffer->Name != nullptr)
+			{
+				separator();
+				file << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->ThreadId << ",\"args\":{\"name\":\"";
+				WriteEscaped(file, buffer->Name);
+				file << "\"}}";
+			}
+
+			for (uint32 i = 0u; i < count; i++)
+			{
+				const ProfileZone& zone = buffer->Zones[i];
+				if (zone.Start < s_State->CaptureStart)
+					continue;
+
+				separator();
+				file << "{\"ph\":\"X\",\"cat\":\"DT\",\"name\":\"";
+				WriteEscaped(file, zone.Name);
+				file << std::format("\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+					buffer->ThreadId, (zone.Start - s_State->CaptureStart) * 0.001, (zone.End - zone.Start) * 0.001);
+			}
+			zoneCount += count;
+			droppedCount += current ? buffer->Dropped.load(std::memory_order_relaxed) : 0u;
+		}
+		file << "\n]}\n";
+
+		LOG_INFO("Profiler capture {}: {} zones", s_State->CapturePath.string(), zoneCount);
+		if (droppedCount > 0u)
+			LOG_WARN("Profiler dropped {} zones, more than {} per thread", droppedCount, s_ZonesPerThread);
+	}
+
+	bool Profiler::IsCapturing()
+	{
+		return s_Capturing.load(std::memory_order_relaxed);
+	}
+
+	void Profiler::SetThreadName(const char* name)
+	{
+		if (s_State)
+			GetThreadBuffer().Name = name;
+	}
+
+	const char* Profiler::InternString(std::string_view string)
+	{
+		std::lock_guard<std::mutex> lock(s_State->Mutex);
+		return s_State->InternedStrings.emplace(string).first->c_str();
+	}
+
+	void Profiler::RecordZone(const char* name, uint64 start, uint64 end)
+	{
+		if (!s_State)
+			return;
+
+		ProfileThreadBuffer& buffer = GetThreadBuffer();
+		uint32 epoch = s_CaptureEpoch.load(std::memory_order_acquire);
+		uint64 state = buffer.State.load(std::memory_order_relaxed);
+		uint32 index = uint32(state);
+		if (uint32(state >> 32u) != epoch)
+		{
+			index = 0u;
+			buffer.Dropped.store(0u, std::memory_order_relaxed);
+		}
+
+		if (index >= s_ZonesPerThread)
+		{
+			buffer.Dropped.fetch_add(1u, std::memory_order_relaxed);
+			return;
+		}
+
+		buffer.Zones[index] = { name, start, end };
+		buffer.State.store(uint64(epoch) << 32u | (index + 1u), std::memory_order_release);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+#include "Core.h"
+#include "AllocationTracker.h"
+
+namespace DT
+{
+	/*
+		scoped zone profiler: zones are recorded into per thread buffers while a capture is
+		active and written as a Chrome trace (chrome://tracing, ui.perfetto.dev) when it ends,
+		nested zones show up as a hierarchy
+	*/
+	class Profiler
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		/* call between frames on the main thread */
+		static void BeginCapture(const std::filesystem::path& filePath);
+		static void EndCapture();
+		static bool IsCapturing();
+
+		/* name shown for the calling thread's track, must outlive the capture */
+		static void SetThreadName(const char* name);
+
+		/* stable copy of a runtime string, valid until Shutdown */
+		static const char* InternString(std::string_view string);
+
+		static void RecordZone(const char* name, uint64 start, uint64 end);
+	};
+
+	/* one zone, and with DT_ENABLE_ALLOCATION_TRACKING the allocation tag of the same scope */
+	class ProfileScope
+	{
+	public:
+		ProfileScope(const char* name)
+			: m_Name(name),
+		#if DT_ENABLE_ALLOCATION_TRACKING
+			m_AllocationScope(name),
+		#endif
+			m_Start(Profiler::IsCapturing() ? Timer::Now() : 0u) {}
+
+		~ProfileScope()
+		{
+			if (m_Start != 0u)
+				Profiler::RecordZone(m_Name, m_Start, Timer::Now());
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator = (const ProfileScope&) = delete;
+	private:
+		const char* m_Name;
+	#if DT_ENABLE_ALLOCATION_TRACKING
+		AllocationScope m_AllocationScope;
+	#endif
+		uint64 m_Start;
+	};
+
+#if DT_ENABLE_PROFILING
+	#define PROFILE_CONCAT_IMPL(a, b) a##b
+	#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+	/* name must outlive the capture: a literal or a Profiler::InternString result; also tags the allocations of the scope */
+	#define PROFILE_SCOPE(name)         ::DT::ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+	#define PROFILE_FUNCTION()          PROFILE_SCOPE(__FUNCTION__)
+	#define PROFILE_THREAD_NAME(name)   ::DT::Profiler::SetThreadName(name)
+#else
+	#define PROFILE_SCOPE(name)         ALLOCATION_SCOPE(name)
+	#define PROFILE_FUNCTION()          PROFILE_SCOPE(__FUNCTION__)
+	#define PROFILE_THREAD_NAME(name)
+#endif
+}
\ No newline at end of file
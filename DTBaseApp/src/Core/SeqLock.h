@@ -0,0 +1,95 @@
+#pragma once
+#include "Core.h"
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <type_traits>
+
+namespace DT
+{
+	/*
+		single writer, many readers: readers never block the writer and retry when a write raced their copy.
+		the value is kept in relaxed atomic words so a torn read is a retry, not undefined behaviour
+	*/
+	template<typename T>
+	class SeqLock
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "SeqLock values are copied word by word");
+	public:
+		SeqLock(const T& value = T())
+		{
+			Store(value);
+		}
+
+		SeqLock(const SeqLock&) = delete;
+		SeqLock& operator=(const SeqLock&) = delete;
+
+		/* any thread */
+		T Load() const
+		{
+			uint64 words[WordCount];
+			uint32 sequence;
+			for (;;)
+			{
+				sequence = m_Sequence.load(std::memory_order_acquire);
+				if (sequence & 1u)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				for (size_t i = 0u; i < WordCount; i++)
+					words[i] = m_Words[i].load(std::memory_order_relaxed);
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (m_Sequence.load(std::memory_order_relaxed) == sequence)
+					break;
+			}
+
+			T value;
+			std::memcpy(&value, words, sizeof(T));
+			return value;
+		}
+
+		/* writer thread only */
+		void Store(const T& value)
+		{
+			m_Value = value;
+			Publish();
+		}
+
+		/* writer thread only: edits the writer's copy in place, then publishes it */
+		template<typename Fn>
+		void Update(Fn&& fn)
+		{
+			fn(m_Value);
+			Publish();
+		}
+
+		/* writer thread only: the writer reads its own copy without retrying */
+		const T& Peek() const { return m_Value; }
+
+		uint32 GetSequence() const { return m_Sequence.load(std::memory_order_acquire); }
+	private:
+		void Publish()
+		{
+			uint64 words[WordCount] = {};
+			std::memcpy(words, &m_Value, sizeof(T));
+
+			uint32 sequence = m_Sequence.load(std::memory_order_relaxed);
+			m_Sequence.store(sequence + 1u, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			for (size_t i = 0u; i < WordCount; i++)
+				m_Words[i].store(words[i], std::memory_order_relaxed);
+
+			m_Sequence.store(sequence + 2u, std::memory_order_release);
+		}
+	private:
+		static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64) - 1u) / sizeof(uint64);
+
+		std::atomic<uint32> m_Sequence = 0u;
+		std::atomic<uint64> m_Words[WordCount];
+		T m_Value;
+	};
+}
\ No newline at end of file
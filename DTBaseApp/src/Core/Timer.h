@@ -1,5 +1,5 @@
 #pragma once
-#include <chrono>
+#include "Clock.h"
 
 namespace DT
 {
@@ -12,26 +12,32 @@ namespace DT
 		}
 		void Reset()
 		{
-			m_Start = clock::now();
+			m_Start = Clock::Now();
+		}
+		/* nanoseconds on the timer clock, only meaningful as a difference */
+		static uint64 Now()
+		{
+			return Clock::Now();
 		}
 		float Mark()
 		{
-			float elapsed = ElapsedSeconds();
-			Reset();
+			return float(Clock::ToSeconds(MarkNanoseconds()));
+		}
+		uint64 MarkNanoseconds()
+		{
+			uint64 now = Clock::Now();
+			uint64 elapsed = now - m_Start;
+			m_Start = now;
 			return elapsed;
 		}
 		uint64 ElapsedNanoseconds() const
 		{
-			clock::time_point now = clock::now();
-			std::chrono::nanoseconds nanoseconds = now - m_Start;
-			return nanoseconds.count();
+			return Clock::Now() - m_Start;
 		}
-		float ElapsedMicroseconds() const { return float(ElapsedNanoseconds() * 0.001); }
-		float ElapsedMilliseconds() const { return float(ElapsedNanoseconds() * 0.001 * 0.001); }
-		float ElapsedSeconds()      const { return float(ElapsedNanoseconds() * 0.001 * 0.001 * 0.001); }
+		double ElapsedMicroseconds() const { return double(ElapsedNanoseconds()) * 1e-3; }
+		double ElapsedMilliseconds() const { return double(ElapsedNanoseconds()) * 1e-6; }
+		double ElapsedSeconds()      const { return Clock::ToSeconds(ElapsedNanoseconds()); }
 	private:
-		using clock = std::chrono::high_resolution_clock;
-
-		clock::time_point m_Start;
+		uint64 m_Start = 0u;
 	};
 }
\ No newline at end of file
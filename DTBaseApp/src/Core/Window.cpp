@@ -0,0 +1,37 @@
+#include "Window.h"
+#include "Platform/WindowsWindow.h"
+#include "Platform/HeadlessWindow.h"
+
+namespace DT
+{
+	Window* Window::Create(const WindowSpecification& specification)
+	{
+		if (specification.Headless)
+			return new HeadlessWindow(specification);
+
+		return new WindowsWindow(specification);
+	}
+
+	std::pair<float, float> Window::GetRawMouseDelta() const
+	{
+		float deltaX = 0.0f;
+		float deltaY = 0.0f;
+		for (const RawMouseSample& sample : m_RawMouseSamples)
+		{
+			deltaX += sample.DeltaX;
+			deltaY += sample.DeltaY;
+		}
+		return { deltaX, deltaY };
+	}
+
+	void Window::BeginRawMouseFrame()
+	{
+		m_RawMouseSamples.clear();
+	}
+
+	void Window::AddRawMouseSample(float deltaX, float deltaY)
+	{
+		/* grows during the first frames of a high rate mouse, then the capacity is reused */
+		m_RawMouseSamples.push_back({ Clock::Now(), deltaX, deltaY });
+	}
+}
\ No newline at end of file
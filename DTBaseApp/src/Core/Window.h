@@ -1,8 +1,22 @@
 #pragma once
-#include "Event.h"
+#include "EventQueue.h"
+#include "SeqLock.h"
+#include <span>
 
 namespace DT
 {
+	/* input injected by the headless backend, consumed at the start of frame "Frame" */
+	struct SyntheticEvent
+	{
+		uint64 Frame = 0u;
+		Event::Type Type = Event::Type::None;
+		int32 Code = 0;   // key code, mouse button or focus state
+		float X = 0.0f;   // cursor x, scroll delta x or new width
+		float Y = 0.0f;   // cursor y, scroll delta y or new height
+	};
+
+	using SyntheticEventGeneratorFn = std::function<void(uint64 frameIndex, std::vector<SyntheticEvent>& events)>;
+
 	struct WindowSpecification
 	{
 		std::string Title    = "Dodge This Base Application";
@@ -15,31 +29,66 @@ namespace DT
 		bool IsDecorated     = true;
 		float StartOpacity   = 1.0f;
 		std::string IconPath = "ApplicationIcon.png";
+
+		/* headless backend: no display, events come from a script and/or a generator */
+		bool Headless                             = false;
+		std::filesystem::path HeadlessScriptPath  = {};
+		SyntheticEventGeneratorFn HeadlessGenerator = {};
+		uint64 HeadlessFrameLimit                 = 0u; // sends a WindowClosedEvent after N frames (0 = never)
+	};
+
+	/* window state kept up to date by the platform callbacks, every geometry query is answered from it */
+	struct WindowGeometry
+	{
+		int32 Width             = 0;    // client area in screen coordinates
+		int32 Height            = 0;
+		int32 FramebufferWidth  = 0;    // client area in pixels
+		int32 FramebufferHeight = 0;
+		int32 PositionX         = 0;
+		int32 PositionY         = 0;
+		float ContentScaleX     = 1.0f;
+		float ContentScaleY     = 1.0f;
+		int32 MouseX            = 0;
+		int32 MouseY            = 0;
+		Extent DisplayResolution = {};  // current mode of the monitor
+		int32 RefreshRate       = 0;
+		bool Fullscreen         = false;
+	};
+
+	/* one unaccelerated relative motion report, Timestamp is the Clock time at which the platform delivered it */
+	struct RawMouseSample
+	{
+		uint64 Timestamp = 0u;
+		float DeltaX = 0.0f;
+		float DeltaY = 0.0f;
 	};
 
 	/* platform independent desktop window */
 	class Window
 	{
 	public:
-		using EventCallbackFn = std::function<void(Event&)>;
-
 		static Window* Create(const WindowSpecification& specification);
 		virtual ~Window() = default;
 
-		virtual void SetEventCallBack(const EventCallbackFn& callback) = 0;
+		/* platform callbacks push into the queue, the application drains it once per frame */
+		virtual void SetEventQueue(EventQueue* queue) = 0;
 		virtual const WindowSpecification& GetSpecification() const = 0;
 
 		virtual void ProcessEvents() = 0;
+		virtual void WaitEvents(float timeoutSeconds) = 0;
 		virtual void Maximize() = 0;
 		virtual void CenterWindow() = 0;
 		virtual void ToFullscreen() = 0;
 		virtual void ToWindowed() = 0;
-		virtual int32 GetWidth() const = 0;
-		virtual int32 GetHeight() const = 0;
-		virtual int32 GetMouseX() const = 0;
-		virtual int32 GetMouseY() const = 0;
 		virtual std::string GetClipboardString() const = 0;
-		virtual Extent GetDisplayResolution() const = 0;
+
+		/* lock free and safe from any thread: never calls into the platform layer */
+		WindowGeometry GetGeometry() const { return m_Geometry.Load(); }
+		int32 GetWidth() const { return GetGeometry().Width; }
+		int32 GetHeight() const { return GetGeometry().Height; }
+		int32 GetMouseX() const { return GetGeometry().MouseX; }
+		int32 GetMouseY() const { return GetGeometry().MouseY; }
+		Extent GetDisplayResolution() const { return GetGeometry().DisplayResolution; }
 
 		virtual void SetFixedAspectRatio(int32 numerator, int32 denominator) = 0;
 		virtual void SetMousePosition(int32 x, int32 y) = 0;
@@ -51,5 +100,26 @@ namespace DT
 		virtual void SetPosition(int32 x, int32 y) = 0;
 		virtual void SetSizeLimits(int32 minWidth, int32 minHeight, int32 maxWidth, int32 maxHeight) = 0;
 		virtual void SetIcon(const std::filesystem::path& iconPath) = 0;
+
+		virtual bool KeyIsPressed(KeyCode key) const = 0;
+		virtual bool MouseIsPressed(MouseCode button) const = 0;
+
+		/*
+			raw mode hides and captures the cursor and reports unaccelerated motion: the samples of the last
+			ProcessEvents() stay available until the next one, their sum is also pushed as a MouseRawInputEvent
+		*/
+		virtual void SetRawMouseInput(bool enabled) = 0;
+		bool IsRawMouseInput() const { return m_RawMouseInput; }
+		std::span<const RawMouseSample> GetRawMouseSamples() const { return m_RawMouseSamples; }
+		std::pair<float, float> GetRawMouseDelta() const;
+	protected:
+		void BeginRawMouseFrame();
+		void AddRawMouseSample(float deltaX, float deltaY);
+	protected:
+		/* written by the thread that processes the window events */
+		SeqLock<WindowGeometry> m_Geometry;
+
+		bool m_RawMouseInput = false;
+		std::vector<RawMouseSample> m_RawMouseSamples;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "Image.h"
+#include "Core/MappedFile.h"
+#include <stb_image.h>
+#include <stb_image_write.h>
+
+namespace DT
+{
+	Image::Image(uint32 width, uint32 height)
+		: m_Width(width), m_Height(height)
+	{
+		std::shared_ptr<uint8[]> pixels(new uint8[GetSize()]);
+		m_Pixels = pixels.get();
+		m_Storage = std::move(pixels);
+	}
+
+	Image::Image(uint32 width, uint32 height, uint8* pixels, std::shared_ptr<const void> storage)
+		: m_Width(width), m_Height(height), m_Pixels(pixels), m_Storage(std::move(storage))
+	{
+	}
+
+	Image Image::Load(const std::filesystem::path& filePath)
+	{
+		/* the decoder reads the mapped file in place: no stdio buffering, no copy of the encoded data */
+		MappedFile file;
+		if (!file.Open(filePath, MappedFileAccess::Read) || file.GetSize() > uint64(INT32_MAX))
+		{
+			LOG_ERROR("Could not open {}", filePath.string());
+			return {};
+		}
+
+		int width, height, channels;
+		const stbi_uc* encoded = reinterpret_cast<const stbi_uc*>(file.GetData());
+		stbi_uc* pixels = stbi_load_from_memory(encoded, (int)file.GetSize(), &width, &height, &channels, Channels);
+		if (pixels == nullptr)
+		{
+			LOG_ERROR("Could not decode {}: {}", filePath.string(), stbi_failure_reason());
+			return {};
+		}
+
+		return Image(uint32(width), uint32(height), pixels, std::shared_ptr<stbi_uc>(pixels, stbi_image_free));
+	}
+
+	bool Image::Save(const std::filesystem::path& filePath, ImageFileFormat format) const
+	{
+		if (!IsValid())
+			return false;
+
+		std::string path = filePath.string();
+		int width = int(m_Width), height = int(m_Height);
+		switch (format)
+		{
+			case ImageFileFormat::Png: return stbi_write_png(path.c_str(), width, height, Channels, m_Pixels, int(GetRowPitch())) != 0;
+			case ImageFileFormat::Tga: return stbi_write_tga(path.c_str(), width, height, Channels, m_Pixels) != 0;
+			case ImageFileFormat::Bmp: return stbi_write_bmp(path.c_str(), width, height, Channels, m_Pixels) != 0;
+		}
+		return false;
+	}
+
+	const char* Image::GetExtension(ImageFileFormat format)
+	{
+		switch (format)
+		{
+			case ImageFileFormat::Png: return ".png";
+			case ImageFileFormat::Tga: return ".tga";
+			case ImageFileFormat::Bmp: return ".bmp";
+		}
+		return "";
+	}
+
+	Image Image::Resize(uint32 width, uint32 height, ImageColorSpace colorSpace) const
+	{
+		if (!IsValid() || width == 0u || height == 0u)
+			return {};
+
+		Image result(width, height);
+		ImageKernels::Resize(m_Pixels, m_Width, m_Height, GetRowPitch(), result.m_Pixels, width, height, result.GetRowPitch(), colorSpace);
+		return result;
+	}
+
+	void Image::PremultiplyAlpha()
+	{
+		ImageKernels::PremultiplyAlpha(m_Pixels, uint64(m_Width) * m_Height);
+	}
+
+	void Image::SwapRedBlue()
+	{
+		ImageKernels::SwapRedBlue(m_Pixels, m_Pixels, uint64(m_Width) * m_Height);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include "Core/Core.h"
+#include "ImageKernels.h"
+
+namespace DT
+{
+	enum class ImageFileFormat : uint8
+	{
+		Png,
+		Tga,
+		Bmp
+	};
+
+	/*
+		8 bit RGBA pixels, rows tightly packed. The storage is shared and type erased so an image can
+		wrap memory it does not allocate itself (a decoder buffer, a mapped file); copies share the pixels
+	*/
+	class Image
+	{
+	public:
+		static constexpr uint32 Channels = 4u;
+	public:
+		Image() = default;
+		/* allocates uninitialized pixels */
+		Image(uint32 width, uint32 height);
+		/* wraps pixels kept alive by storage */
+		Image(uint32 width, uint32 height, uint8* pixels, std::shared_ptr<const void> storage);
+
+		/* synchronous decode of any format stb_image reads, from a mapping of the file; an invalid image on failure */
+		static Image Load(const std::filesystem::path& filePath);
+		/* encodes with stb_image_write, false if the file could not be written */
+		bool Save(const std::filesystem::path& filePath, ImageFileFormat format) const;
+		static const char* GetExtension(ImageFileFormat format);
+
+		bool IsValid() const { return m_Pixels != nullptr; }
+		uint32 GetWidth() const { return m_Width; }
+		uint32 GetHeight() const { return m_Height; }
+		uint64 GetRowPitch() const { return uint64(m_Width) * Channels; }
+		uint64 GetSize() const { return GetRowPitch() * m_Height; }
+
+		/* a new image filtered with ImageKernels::Resize, color channels blended in linear light for sRGB */
+		Image Resize(uint32 width, uint32 height, ImageColorSpace colorSpace = ImageColorSpace::Srgb) const;
+		/* in place: every copy sharing these pixels sees the change */
+		void PremultiplyAlpha();
+		void SwapRedBlue();
+
+		uint8* GetPixels() { return m_Pixels; }
+		const uint8* GetPixels() const { return m_Pixels; }
+		uint8* GetRow(uint32 y) { return m_Pixels + y * GetRowPitch(); }
+		const uint8* GetRow(uint32 y) const { return m_Pixels + y * GetRowPitch(); }
+	private:
+		uint32 m_Width = 0u;
+		uint32 m_Height = 0u;
+		uint8* m_Pixels = nullptr;
+		std::shared_ptr<const void> m_Storage;
+	};
+}
\ No newline at end of file
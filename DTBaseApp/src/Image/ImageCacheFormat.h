@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+
+/*
+	layout of the .dtimg files written next to decoded source images (all values little endian)
+
+	file : FileHeader, padding, mip 0, padding, mip 1, ...
+
+	every mip level is tightly packed RGBA8 starting on a PixelAlignment boundary, so the file can be
+	mapped and its pixels used in place. A cache file is valid while the size and write time of its
+	source match the ones recorded in the header
+*/
+namespace DT::ImageCacheFormat
+{
+	inline constexpr char Magic[8] = { 'D', 'T', 'I', 'M', 'A', 'G', 'E', '\0' };
+	inline constexpr uint32_t Version = 1u;
+	inline constexpr uint64_t PixelAlignment = 4096u;
+	inline constexpr uint32_t MaxMipCount = 16u;
+	inline constexpr const char* Extension = ".dtimg";
+
+	struct MipLevel
+	{
+		uint64_t Offset; // from the start of the file
+		uint32_t Width;
+		uint32_t Height;
+	};
+
+	struct FileHeader
+	{
+		char Magic[8];
+		uint32_t Version;
+		uint32_t MipCount;
+		uint64_t SourceSize;
+		int64_t SourceWriteTime; // std::filesystem::file_time_type ticks
+		MipLevel Mips[MaxMipCount];
+	};
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "ImageCapture.h"
+#include "Core/Profiler.h"
+
+namespace DT
+{
+	ImageCapture::~ImageCapture()
+	{
+		Stop();
+	}
+
+	void ImageCapture::Start(const ImageCaptureSpecification& specification)
+	{
+		ASSERT(!IsRunning());
+
+		m_Specification = specification;
+		m_Specification.QueueSize = std::max(m_Specification.QueueSize, 1u);
+
+		std::error_code error;
+		std::filesystem::create_directories(m_Specification.Directory, error);
+		if (error)
+			LOG_ERROR("Could not create {}: {}", m_Specification.Directory.string(), error.message());
+
+		m_Frames.assign(m_Specification.QueueSize, {});
+		m_FreeFrames.clear();
+		for (uint32 i = m_Specification.QueueSize; i > 0u; i--)
+			m_FreeFrames.push_back(i - 1u);
+		m_PendingFrames.clear();
+		m_StopRequested = false;
+		m_Statistics = {};
+
+		uint32 threadCount = m_Specification.EncoderThreadCount;
+		if (threadCount == 0u)
+			threadCount = std::max(std::thread::hardware_concurrency() / 2u, 1u);
+		for (uint32 i = 0u; i < threadCount; i++)
+			m_Threads.emplace_back(&ImageCapture::EncoderThreadMain, this, i);
+	}
+
+	void ImageCapture::Stop()
+	{
+		if (!IsRunning())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_StopRequested = true;
+		}
+		m_Condition.notify_all();
+		for (std::thread& thread : m_Threads)
+			thread.join();
+		m_Threads.clear();
+
+		const Statistics& statistics = m_Statistics;
+		LOG_INFO("Capture: {} frames written to {}, {} dropped, {} failed, {} blocked submits ({:.1f}ms)",
+			statistics.Written, m_Specification.Directory.string(), statistics.Dropped, statistics.Failed,
+			statistics.Blocked, double(statistics.BlockedNanoseconds) * 1e-6);
+		m_Frames.clear();
+		m_FreeFrames.clear();
+	}
+
+	bool ImageCapture::Submit(const uint8* pixels, uint32 width, uint32 height, uint64 pitch, bool bottomUp)
+	{
+		PROFILE_FUNCTION();
+		ASSERT(IsRunning());
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		uint64 number = m_Statistics.Submitted++;
+		if (m_FreeFrames.empty())
+		{
+			switch (m_Specification.OverflowPolicy)
+			{
+				case CaptureOverflowPolicy::Block:
+				{
+					Timer timer;
+					m_Condition.wait(lock, [this] { return !m_FreeFrames.empty(); });
+					m_Statistics.Blocked++;
+					m_Statistics.BlockedNanoseconds += timer.ElapsedNanoseconds();
+					break;
+				}
+				case CaptureOverflowPolicy::DropOldest:
+				{
+					/* every slot may be held by an encoder, then there is nothing older to replace */
+					m_Statistics.Dropped++;
+					if (m_PendingFrames.empty())
+						return false;
+					m_FreeFrames.push_back(m_PendingFrames.front());
+					m_PendingFrames.pop_front();
+					break;
+				}
+				case CaptureOverflowPolicy::DropNewest:
+				{
+					m_Statistics.Dropped++;
+					return false;
+				}
+			}
+		}
+
+		uint32 index = m_FreeFrames.back();
+		m_FreeFrames.pop_back();
+		lock.unlock();
+
+		/* the slot belongs to this thread until it is queued: copy without the lock */
+		Frame& frame = m_Frames[index];
+		if (frame.Pixels.GetWidth() != width || frame.Pixels.GetHeight() != height)
+			frame.Pixels = Image(width, height);
+		frame.Number = number;
+		for (uint32 y = 0u; y < height; y++)
+		{
+			const uint8* row = pixels + (bottomUp ? height - 1u - y : y) * pitch;
+			std::copy(row, row + frame.Pixels.GetRowPitch(), frame.Pixels.GetRow(y));
+		}
+
+		lock.lock();
+		m_PendingFrames.push_back(index);
+		uint32 queued = m_Specification.QueueSize - uint32(m_FreeFrames.size());
+		m_Statistics.PeakQueued = std::max(m_Statistics.PeakQueued, queued);
+		lock.unlock();
+		m_Condition.notify_all();
+		return true;
+	}
+
+	bool ImageCapture::Submit(const Image& image)
+	{
+		return image.IsValid() && Submit(image.GetPixels(), image.GetWidth(), image.GetHeight(), image.GetRowPitch());
+	}
+
+	void ImageCapture::Flush()
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Condition.wait(lock, [this] { return m_FreeFrames.size() == m_Frames.size(); });
+	}
+
+	ImageCapture::Statistics ImageCapture::GetStatistics() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		Statistics statistics = m_Statistics;
+		statistics.Queued = uint32(m_Frames.size() - m_FreeFrames.size());
+		return statistics;
+	}
+
+	void ImageCapture::EncoderThreadMain(uint32 threadIndex)
+	{
+		PROFILE_THREAD_NAME(Profiler::InternString(std::format("Capture Encoder {}", threadIndex)));
+
+		const char* extension = Image::GetExtension(m_Specification.Format);
+		while (true)
+		{
+			uint32 index = 0u;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_Condition.wait(lock, [this]
+				{
+					return !m_PendingFrames.empty() || m_StopRequested;
+				});
+
+				if (m_PendingFrames.empty())
+					return;
+
+				index = m_PendingFrames.front();
+				m_PendingFrames.pop_front();
+			}
+
+			const Frame& frame = m_Frames[index];
+			std::filesystem::path path = m_Specification.Directory / std::format("{}_{:06}{}", m_Specification.Name, frame.Number, extension);
+			Timer timer;
+			bool written = frame.Pixels.Save(path, m_Specification.Format);
+			uint64 elapsed = timer.ElapsedNanoseconds();
+			if (!written)
+				LOG_ERROR("Could not write {}", path.string());
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				(written ? m_Statistics.Written : m_Statistics.Failed)++;
+				m_Statistics.EncodeNanoseconds += elapsed;
+				m_FreeFrames.push_back(index);
+			}
+			m_Condition.notify_all();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#include "Image.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace DT
+{
+	enum class CaptureOverflowPolicy : uint8
+	{
+		Block,      // Submit waits for a free slot, nothing is lost
+		DropNewest, // the submitted frame is dropped
+		DropOldest  // the oldest frame no encoder has started is replaced
+	};
+
+	struct ImageCaptureSpecification
+	{
+		std::filesystem::path Directory = "Captures";
+		std::string Name = "Frame";     // files are <Name>_<submission number>.<extension>, gaps are dropped frames
+		ImageFileFormat Format = ImageFileFormat::Png;
+		uint32 QueueSize = 8u;          // frames copied and not yet written, their memory is reused
+		uint32 EncoderThreadCount = 0u; // 0 = half the hardware threads, at least one
+		CaptureOverflowPolicy OverflowPolicy = CaptureOverflowPolicy::DropNewest;
+	};
+
+	/* copies submitted frames into a bounded set of slots and writes them to files on encoder threads */
+	class ImageCapture
+	{
+	public:
+		struct Statistics
+		{
+			uint64 Submitted = 0u;
+			uint64 Written = 0u;
+			uint64 Failed = 0u;
+			uint64 Dropped = 0u;
+			uint64 Blocked = 0u;            // Submit calls that waited for a slot
+			uint64 BlockedNanoseconds = 0u;
+			uint64 EncodeNanoseconds = 0u;  // summed over the encoder threads
+			uint32 Queued = 0u;             // copied and not yet written
+			uint32 PeakQueued = 0u;
+		};
+	public:
+		ImageCapture() = default;
+		~ImageCapture();
+
+		void Start(const ImageCaptureSpecification& specification);
+		/* writes every queued frame, then joins the encoder threads */
+		void Stop();
+		bool IsRunning() const { return !m_Threads.empty(); }
+
+		/* copies the frame, rows pitch bytes apart (bottom row first when bottomUp); false if it was dropped */
+		bool Submit(const uint8* pixels, uint32 width, uint32 height, uint64 pitch, bool bottomUp = false);
+		bool Submit(const Image& image);
+
+		/* blocks until every accepted frame is written */
+		void Flush();
+
+		Statistics GetStatistics() const;
+	private:
+		void EncoderThreadMain(uint32 threadIndex);
+	private:
+		struct Frame
+		{
+			Image Pixels;
+			uint64 Number = 0u;
+		};
+
+		ImageCaptureSpecification m_Specification;
+		std::vector<std::thread> m_Threads;
+		std::vector<Frame> m_Frames;
+
+		mutable std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		std::vector<uint32> m_FreeFrames;
+		std::deque<uint32> m_PendingFrames; // copied, no encoder has started them
+		bool m_StopRequested = false;
+		Statistics m_Statistics;
+	};
+}
\ No newline at end of file
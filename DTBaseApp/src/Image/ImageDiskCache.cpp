@@ -0,0 +1,105 @@
+#include "ImageDiskCache.h"
+#include "ImageCacheFormat.h"
+#include "Core/MappedFile.h"
+#include <random>
+
+namespace DT
+{
+	static bool GetSourceStamp(const std::filesystem::path& sourcePath, uint64& size, int64& writeTime)
+	{
+		std::error_code error;
+		size = std::filesystem::file_size(sourcePath, error);
+		if (error)
+			return false;
+
+		writeTime = std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count();
+		return !error;
+	}
+
+	static uint64 AlignUp(uint64 value, uint64 alignment)
+	{
+		return (value + alignment - 1u) & ~(alignment - 1u);
+	}
+
+	std::filesystem::path ImageDiskCache::GetCachePath(const std::filesystem::path& sourcePath)
+	{
+		std::filesystem::path cachePath = sourcePath;
+		cachePath += ImageCacheFormat::Extension;
+		return cachePath;
+	}
+
+	Image ImageDiskCache::Read(const std::filesystem::path& sourcePath)
+	{
+		uint64 sourceSize;
+		int64 sourceWriteTime;
+		if (!GetSourceStamp(sourcePath, sourceSize, sourceWriteTime))
+			return {};
+
+		/* copy on write: the pixels can be edited in place like a decoded image, the file is never touched */
+		std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+		if (!file->Open(GetCachePath(sourcePath), MappedFileAccess::CopyOnWrite) || file->GetSize() < sizeof(ImageCacheFormat::FileHeader))
+			return {};
+
+		const ImageCacheFormat::FileHeader* header = reinterpret_cast<const ImageCacheFormat::FileHeader*>(file->GetData());
+		if (std::memcmp(header->Magic, ImageCacheFormat::Magic, sizeof(header->Magic)) != 0 || header->Version != ImageCacheFormat::Version)
+			return {};
+		if (header->SourceSize != sourceSize || header->SourceWriteTime != sourceWriteTime)
+			return {};
+		if (header->MipCount == 0u || header->MipCount > ImageCacheFormat::MaxMipCount)
+			return {};
+
+		const ImageCacheFormat::MipLevel& mip = header->Mips[0];
+		uint64 mipSize = uint64(mip.Width) * mip.Height * Image::Channels;
+		if (mip.Width == 0u || mip.Height == 0u || mip.Offset % ImageCacheFormat::PixelAlignment != 0u)
+			return {};
+		/* a corrupt offset must not wrap the end of the range around */
+		if (mip.Offset > file->GetSize() || mipSize > file->GetSize() - mip.Offset)
+			return {};
+
+		uint8* pixels = reinterpret_cast<uint8*>(file->GetData() + mip.Offset);
+		return Image(mip.Width, mip.Height, pixels, std::move(file));
+	}
+
+	bool ImageDiskCache::Write(const std::filesystem::path& sourcePath, const Image& image)
+	{
+		uint64 sourceSize;
+		int64 sourceWriteTime;
+		if (!image.IsValid() || !GetSourceStamp(sourcePath, sourceSize, sourceWriteTime))
+			return false;
+
+		ImageCacheFormat::FileHeader header = {};
+		std::memcpy(header.Magic, ImageCacheFormat::Magic, sizeof(header.Magic));
+		header.Version = ImageCacheFormat::Version;
+		header.MipCount = 1u;
+		header.SourceSize = sourceSize;
+		header.SourceWriteTime = sourceWriteTime;
+		header.Mips[0] = { AlignUp(sizeof(header), ImageCacheFormat::PixelAlignment), image.GetWidth(), image.GetHeight() };
+
+		std::filesystem::path cachePath = GetCachePath(sourcePath);
+		std::filesystem::path temporaryPath = cachePath;
+		/* random so that threads and processes warming the same asset never share a temporary file */
+		std::random_device random;
+		temporaryPath += std::format(".{:08x}{:08x}.tmp", random(), random());
+
+		{
+			MappedFile file;
+			if (!file.Open(temporaryPath, MappedFileAccess::ReadWrite, header.Mips[0].Offset + image.GetSize()))
+			{
+				LOG_WARN("Could not write the image cache {}", cachePath.string());
+				return false;
+			}
+
+			std::memcpy(file.GetData(), &header, sizeof(header));
+			std::memcpy(file.GetData() + header.Mips[0].Offset, image.GetPixels(), image.GetSize());
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, cachePath, error);
+		if (error)
+		{
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+#include "Image.h"
+
+namespace DT
+{
+	/* decoded images stored next to their source as .dtimg files (see ImageCacheFormat.h), mapped back without decoding */
+	class ImageDiskCache
+	{
+	public:
+		static std::filesystem::path GetCachePath(const std::filesystem::path& sourcePath);
+
+		/* maps the cache file of sourcePath, an invalid image if it is missing, corrupt or older than the source */
+		static Image Read(const std::filesystem::path& sourcePath);
+		/* writes a temporary file and renames it into place, a reader never sees a partial file */
+		static bool Write(const std::filesystem::path& sourcePath, const Image& image);
+	};
+}
\ No newline at end of file
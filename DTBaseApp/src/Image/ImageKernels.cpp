@@ -0,0 +1,708 @@
+#include "ImageKernels.h"
+#include <stb_image_resize.h>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define DT_IMAGE_SIMD 1
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define DT_TARGET_AVX2
+	#else
+		#include <cpuid.h>
+		#include <immintrin.h>
+		#define DT_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+namespace DT
+{
+	/* output pixel x blends Count source pixels from Start with Weights[x * MaxTaps], edges folded into the border pixel */
+	struct FilterAxis
+	{
+		std::vector<uint32> Start;
+		std::vector<uint32> Count;
+		std::vector<float> Weights;
+		uint32 MaxTaps = 0u;
+	};
+
+	struct KernelTable
+	{
+		void (*DecodeRow)(const uint8* source, float* destination, uint64 pixelCount, ImageColorSpace colorSpace);
+		void (*EncodeRow)(const float* source, uint8* destination, uint64 pixelCount, ImageColorSpace colorSpace);
+		void (*FilterHorizontal)(const float* source, float* destination, const FilterAxis& axis);
+		void (*FilterVertical)(const float* const* rows, const float* weights, uint32 count, float* destination, uint64 floatCount);
+		void (*Halve)(const float* source, uint32 sourceWidth, uint32 sourceHeight, float* destination);
+		void (*PremultiplyAlpha)(uint8* pixels, uint64 pixelCount);
+		void (*SwapRedBlue)(const uint8* source, uint8* destination, uint64 pixelCount);
+	};
+
+	static constexpr float InverseByteMax = 1.0f / 255.0f;
+	static constexpr uint32 SrgbEncodeSteps = 4095u;
+
+	struct ColorTables
+	{
+		float SrgbToLinear[256];
+		uint8 LinearToSrgb[SrgbEncodeSteps + 1u]; // indexed by round(linear * 4095)
+	};
+
+	static const ColorTables& GetColorTables()
+	{
+		static const ColorTables tables = []
+		{
+			ColorTables result;
+			for (uint32 i = 0u; i < 256u; i++)
+			{
+				double c = i / 255.0;
+				result.SrgbToLinear[i] = float(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+			}
+			for (uint32 i = 0u; i <= SrgbEncodeSteps; i++)
+			{
+				double l = double(i) / SrgbEncodeSteps;
+				double c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+				result.LinearToSrgb[i] = uint8(std::lround(std::clamp(c, 0.0, 1.0) * 255.0));
+			}
+			return result;
+		}();
+		return tables;
+	}
+
+	/* ---- scalar: the definition every other level has to match ---- */
+
+	static void DecodeRowScalar(const uint8* source, float* destination, uint64 pixelCount, ImageColorSpace colorSpace)
+	{
+		const float* table = GetColorTables().SrgbToLinear;
+		for (uint64 i = 0u; i < pixelCount * 4u; i += 4u)
+		{
+			for (uint32 c = 0u; c < 3u; c++)
+				destination[i + c] = colorSpace == ImageColorSpace::Srgb ? table[source[i + c]] : float(source[i + c]) * InverseByteMax;
+			destination[i + 3u] = float(source[i + 3u]) * InverseByteMax;
+		}
+	}
+
+	static void EncodeRowScalar(const float* source, uint8* destination, uint64 pixelCount, ImageColorSpace colorSpace)
+	{
+		const uint8* table = GetColorTables().LinearToSrgb;
+		for (uint64 i = 0u; i < pixelCount * 4u; i += 4u)
+		{
+			for (uint32 c = 0u; c < 3u; c++)
+			{
+				float value = std::min(std::max(source[i + c], 0.0f), 1.0f);
+				if (colorSpace == ImageColorSpace::Srgb)
+					destination[i + c] = table[std::lrint(value * float(SrgbEncodeSteps))];
+				else
+					destination[i + c] = uint8(std::lrint(value * 255.0f));
+			}
+			destination[i + 3u] = uint8(std::lrint(std::min(std::max(source[i + 3u], 0.0f), 1.0f) * 255.0f));
+		}
+	}
+
+	static void FilterHorizontalScalar(const float* source, float* destination, const FilterAxis& axis)
+	{
+		for (uint64 x = 0u; x < axis.Start.size(); x++)
+		{
+			const float* weights = &axis.Weights[x * axis.MaxTaps];
+			const float* pixel = source + uint64(axis.Start[x]) * 4u;
+			float sum[4] = {};
+			for (uint32 j = 0u; j < axis.Count[x]; j++, pixel += 4)
+				for (uint32 c = 0u; c < 4u; c++)
+					sum[c] = sum[c] + weights[j] * pixel[c];
+			std::memcpy(destination + x * 4u, sum, sizeof(sum));
+		}
+	}
+
+	static void FilterVerticalScalar(const float* const* rows, const float* weights, uint32 count, float* destination, uint64 floatCount)
+	{
+		for (uint64 i = 0u; i < floatCount; i++)
+		{
+			float sum = 0.0f;
+			for (uint32 j = 0u; j < count; j++)
+				sum = sum + weights[j] * rows[j][i];
+			destination[i] = sum;
+		}
+	}
+
+	/* source pixels [first, first + count) along one axis feeding destination pixel i */
+	static uint32 GetHalveTaps(uint32 sourceSize, uint32 i, uint32& first)
+	{
+		if (sourceSize == 1u)
+		{
+			first = 0u;
+			return 1u;
+		}
+		first = i * 2u;
+		return (sourceSize & 1u) != 0u && i == sourceSize / 2u - 1u ? 3u : 2u;
+	}
+
+	static void HalveScalar(const float* source, uint32 sourceWidth, uint32 sourceHeight, float* destination)
+	{
+		uint32 width = ImageKernels::GetHalvedSize(sourceWidth);
+		uint32 height = ImageKernels::GetHalvedSize(sourceHeight);
+		for (uint32 y = 0u; y < height; y++)
+		{
+			uint32 firstRow;
+			uint32 rowCount = GetHalveTaps(sourceHeight, y, firstRow);
+			for (uint32 x = 0u; x < width; x++)
+			{
+				uint32 firstColumn;
+				uint32 columnCount = GetHalveTaps(sourceWidth, x, firstColumn);
+				float sum[4] = {};
+				for (uint32 j = 0u; j < rowCount; j++)
+				{
+					const float* pixel = source + (uint64(firstRow + j) * sourceWidth + firstColumn) * 4u;
+					for (uint32 i = 0u; i < columnCount; i++, pixel += 4)
+						for (uint32 c = 0u; c < 4u; c++)
+							sum[c] = sum[c] + pixel[c];
+				}
+				float scale = 1.0f / float(rowCount * columnCount);
+				float* out = destination + (uint64(y) * width + x) * 4u;
+				for (uint32 c = 0u; c < 4u; c++)
+					out[c] = sum[c] * scale;
+			}
+		}
+	}
+
+	static void PremultiplyAlphaScalar(uint8* pixels, uint64 pixelCount)
+	{
+		/* round(c * a / 255) without a division */
+		for (uint64 i = 0u; i < pixelCount * 4u; i += 4u)
+		{
+			uint32 alpha = pixels[i + 3u];
+			for (uint32 c = 0u; c < 3u; c++)
+			{
+				uint32 x = pixels[i + c] * alpha + 128u;
+				pixels[i + c] = uint8((x + (x >> 8u)) >> 8u);
+			}
+		}
+	}
+
+	static void SwapRedBlueScalar(const uint8* source, uint8* destination, uint64 pixelCount)
+	{
+		for (uint64 i = 0u; i < pixelCount; i++)
+		{
+			uint32 pixel;
+			std::memcpy(&pixel, source + i * 4u, 4u);
+			uint32 redBlue = pixel & 0x00FF00FFu;
+			pixel = (pixel & 0xFF00FF00u) | (redBlue << 16u) | (redBlue >> 16u);
+			std::memcpy(destination + i * 4u, &pixel, 4u);
+		}
+	}
+
+#if DT_IMAGE_SIMD
+	/* ---- SSE2: part of x64, always available ---- */
+
+	static void DecodeRowSSE2(const uint8* source, float* destination, uint64 pixelCount, ImageColorSpace colorSpace)
+	{
+		const float* table = GetColorTables().SrgbToLinear;
+		const __m128 scale = _mm_set1_ps(InverseByteMax);
+		const __m128i zero = _mm_setzero_si128();
+		uint64 i = 0u;
+		if (colorSpace == ImageColorSpace::Linear)
+		{
+			for (; i + 4u <= pixelCount; i += 4u)
+			{
+				__m128i bytes = _mm_loadu_si128((const __m128i*)(source + i * 4u));
+				__m128i low = _mm_unpacklo_epi8(bytes, zero);
+				__m128i high = _mm_unpackhi_epi8(bytes, zero);
+				float* out = destination + i * 4u;
+				_mm_storeu_ps(out + 0u,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+				_mm_storeu_ps(out + 4u,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+				_mm_storeu_ps(out + 8u,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+				_mm_storeu_ps(out + 12u, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+			}
+		}
+		else
+		{
+			for (; i < pixelCount; i++)
+			{
+				const uint8* pixel = source + i * 4u;
+				__m128 value = _mm_set_ps(float(pixel[3]) * InverseByteMax, table[pixel[2]], table[pixel[1]], table[pixel[0]]);
+				_mm_storeu_ps(destination + i * 4u, value);
+			}
+		}
+		DecodeRowScalar(source + i * 4u, destination + i * 4u, pixelCount - i, colorSpace);
+	}
+
+	static void EncodeRowSSE2(const float* source, uint8* destination, uint64 pixelCount, ImageColorSpace colorSpace)
+	{
+		const uint8* table = GetColorTables().LinearToSrgb;
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		uint64 i = 0u;
+		if (colorSpace == ImageColorSpace::Linear)
+		{
+			const __m128 scale = _mm_set1_ps(255.0f);
+			auto convert = [&](const float* p) { return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(p), zero), one), scale)); };
+			for (; i + 4u <= pixelCount; i += 4u)
+			{
+				const float* in = source + i * 4u;
+				__m128i low = _mm_packs_epi32(convert(in + 0u), convert(in + 4u));
+				__m128i high = _mm_packs_epi32(convert(in + 8u), convert(in + 12u));
+				_mm_storeu_si128((__m128i*)(destination + i * 4u), _mm_packus_epi16(low, high));
+			}
+		}
+		else
+		{
+			const __m128 scale = _mm_set_ps(255.0f, float(SrgbEncodeSteps), float(SrgbEncodeSteps), float(SrgbEncodeSteps));
+			alignas(16) int32 index[4];
+			for (; i < pixelCount; i++)
+			{
+				__m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i * 4u), zero), one);
+				_mm_store_si128((__m128i*)index, _mm_cvtps_epi32(_mm_mul_ps(value, scale)));
+				uint8* out = destination + i * 4u;
+				out[0] = table[index[0]];
+				out[1] = table[index[1]];
+				out[2] = table[index[2]];
+				out[3] = uint8(index[3]);
+			}
+		}
+		EncodeRowScalar(source + i * 4u, destination + i * 4u, pixelCount - i, colorSpace);
+	}
+
+	/* one RGBA pixel is one register, the taps differ per pixel so this is shared by the AVX2 level */
+	static void FilterHorizontalSSE2(const float* source, float* destination, const FilterAxis& axis)
+	{
+		for (uint64 x = 0u; x < axis.Start.size(); x++)
+		{
+			const float* weights = &axis.Weights[x * axis.MaxTaps];
+			const float* pixel = source + uint64(axis.Start[x]) * 4u;
+			__m128 sum = _mm_setzero_ps();
+			for (uint32 j = 0u; j < axis.Count[x]; j++, pixel += 4)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[j]), _mm_loadu_ps(pixel)));
+			_mm_storeu_ps(destination + x * 4u, sum);
+		}
+	}
+
+	static void FilterVerticalSSE2(const float* const* rows, const float* weights, uint32 count, float* destination, uint64 floatCount)
+	{
+		uint64 i = 0u;
+		for (; i + 4u <= floatCount; i += 4u)
+		{
+			__m128 sum = _mm_setzero_ps();
+			for (uint32 j = 0u; j < count; j++)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[j]), _mm_loadu_ps(rows[j] + i)));
+			_mm_storeu_ps(destination + i, sum);
+		}
+		for (; i < floatCount; i++)
+		{
+			float sum = 0.0f;
+			for (uint32 j = 0u; j < count; j++)
+				sum = sum + weights[j] * rows[j][i];
+			destination[i] = sum;
+		}
+	}
+
+	/* same sums in the same order as the scalar version, one pixel per register */
+	static void HalveSSE2(const float* source, uint32 sourceWidth, uint32 sourceHeight, float* destination)
+	{
+		uint32 width = ImageKernels::GetHalvedSize(sourceWidth);
+		uint32 height = ImageKernels::GetHalvedSize(sourceHeight);
+		for (uint32 y = 0u; y < height; y++)
+		{
+			uint32 firstRow;
+			uint32 rowCount = GetHalveTaps(sourceHeight, y, firstRow);
+			for (uint32 x = 0u; x < width; x++)
+			{
+				uint32 firstColumn;
+				uint32 columnCount = GetHalveTaps(sourceWidth, x, firstColumn);
+				__m128 sum = _mm_setzero_ps();
+				for (uint32 j = 0u; j < rowCount; j++)
+				{
+					const float* pixel = source + (uint64(firstRow + j) * sourceWidth + firstColumn) * 4u;
+					for (uint32 i = 0u; i < columnCount; i++, pixel += 4)
+						sum = _mm_add_ps(sum, _mm_loadu_ps(pixel));
+				}
+				__m128 scale = _mm_set1_ps(1.0f / float(rowCount * columnCount));
+				_mm_storeu_ps(destination + (uint64(y) * width + x) * 4u, _mm_mul_ps(sum, scale));
+			}
+		}
+	}
+
+	static void PremultiplyAlphaSSE2(uint8* pixels, uint64 pixelCount)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i bias = _mm_set1_epi16(128);
+		const __m128i alphaMask = _mm_set1_epi32(int32(0xFF000000u));
+		auto premultiply = [&](__m128i color)
+		{
+			/* broadcast each pixel's alpha word over its four words */
+			__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(color, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			__m128i x = _mm_add_epi16(_mm_mullo_epi16(color, alpha), bias);
+			return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+		};
+
+		uint64 i = 0u;
+		for (; i + 4u <= pixelCount; i += 4u)
+		{
+			__m128i* address = (__m128i*)(pixels + i * 4u);
+			__m128i bytes = _mm_loadu_si128(address);
+			__m128i result = _mm_packus_epi16(premultiply(_mm_unpacklo_epi8(bytes, zero)), premultiply(_mm_unpackhi_epi8(bytes, zero)));
+			result = _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(alphaMask, bytes));
+			_mm_storeu_si128(address, result);
+		}
+		PremultiplyAlphaScalar(pixels + i * 4u, pixelCount - i);
+	}
+
+	static void SwapRedBlueSSE2(const uint8* source, uint8* destination, uint64 pixelCount)
+	{
+		const __m128i redBlueMask = _mm_set1_epi32(0x00FF00FF);
+		uint64 i = 0u;
+		for (; i + 4u <= pixelCount; i += 4u)
+		{
+			__m128i pixel = _mm_loadu_si128((const __m128i*)(source + i * 4u));
+			__m128i redBlue = _mm_and_si128(pixel, redBlueMask);
+			__m128i swapped = _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16));
+			_mm_storeu_si128((__m128i*)(destination + i * 4u), _mm_or_si128(_mm_andnot_si128(redBlueMask, pixel), swapped));
+		}
+		SwapRedBlueScalar(source + i * 4u, destination + i * 4u, pixelCount - i);
+	}
+
+	/* ---- AVX2: compiled for every x64 build, only called when cpuid reports it ---- */
+
+	DT_TARGET_AVX2 static void DecodeRowAVX2(const uint8* source, float* destination, uint64 pixelCount, ImageColorSpace colorSpace)
+	{
+		const float* table = GetColorTables().SrgbToLinear;
+		const __m256 scale = _mm256_set1_ps(InverseByteMax);
+		/* blends the linear alpha lanes over the gathered color lanes */
+		const __m256 alphaLanes = _mm256_castsi256_ps(_mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1));
+		uint64 i = 0u;
+		for (; i + 2u <= pixelCount; i += 2u)
+		{
+			__m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(source + i * 4u)));
+			__m256 linear = _mm256_mul_ps(_mm256_cvtepi32_ps(index), scale);
+			if (colorSpace == ImageColorSpace::Srgb)
+				linear = _mm256_blendv_ps(_mm256_i32gather_ps(table, index, 4), linear, alphaLanes);
+			_mm256_storeu_ps(destination + i * 4u, linear);
+		}
+		DecodeRowScalar(source + i * 4u, destination + i * 4u, pixelCount - i, colorSpace);
+	}
+
+	DT_TARGET_AVX2 static void EncodeRowAVX2(const float* source, uint8* destination, uint64 pixelCount, ImageColorSpace colorSpace)
+	{
+		const uint8* table = GetColorTables().LinearToSrgb;
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 one = _mm256_set1_ps(1.0f);
+		uint64 i = 0u;
+		if (colorSpace == ImageColorSpace::Linear)
+		{
+			const __m256 scale = _mm256_set1_ps(255.0f);
+			/* the packs work per 128 bit lane, the permute puts the pixels back in order */
+			const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			auto convert = [&](const float* p) DT_TARGET_AVX2 { return _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(p), zero), one), scale)); };
+			for (; i + 8u <= pixelCount; i += 8u)
+			{
+				const float* in = source + i * 4u;
+				__m256i low = _mm256_packs_epi32(convert(in + 0u), convert(in + 8u));
+				__m256i high = _mm256_packs_epi32(convert(in + 16u), convert(in + 24u));
+				__m256i bytes = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(low, high), order);
+				_mm256_storeu_si256((__m256i*)(destination + i * 4u), bytes);
+			}
+		}
+		else
+		{
+			const float steps = float(SrgbEncodeSteps);
+			const __m256 scale = _mm256_setr_ps(steps, steps, steps, 255.0f, steps, steps, steps, 255.0f);
+			alignas(32) int32 index[8];
+			for (; i + 2u <= pixelCount; i += 2u)
+			{
+				__m256 value = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(source + i * 4u), zero), one);
+				_mm256_store_si256((__m256i*)index, _mm256_cvtps_epi32(_mm256_mul_ps(value, scale)));
+				uint8* out = destination + i * 4u;
+				out[0] = table[index[0]];
+				out[1] = table[index[1]];
+				out[2] = table[index[2]];
+				out[3] = uint8(index[3]);
+				out[4] = table[index[4]];
+				out[5] = table[index[5]];
+				out[6] = table[index[6]];
+				out[7] = uint8(index[7]);
+			}
+		}
+		EncodeRowScalar(source + i * 4u, destination + i * 4u, pixelCount - i, colorSpace);
+	}
+
+	DT_TARGET_AVX2 static void FilterVerticalAVX2(const float* const* rows, const float* weights, uint32 count, float* destination, uint64 floatCount)
+	{
+		uint64 i = 0u;
+		for (; i + 8u <= floatCount; i += 8u)
+		{
+			__m256 sum = _mm256_setzero_ps();
+			for (uint32 j = 0u; j < count; j++)
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(weights[j]), _mm256_loadu_ps(rows[j] + i)));
+			_mm256_storeu_ps(destination + i, sum);
+		}
+		for (; i < floatCount; i++)
+		{
+			float sum = 0.0f;
+			for (uint32 j = 0u; j < count; j++)
+				sum = sum + weights[j] * rows[j][i];
+			destination[i] = sum;
+		}
+	}
+
+	DT_TARGET_AVX2 static void PremultiplyAlphaAVX2(uint8* pixels, uint64 pixelCount)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i bias = _mm256_set1_epi16(128);
+		const __m256i alphaMask = _mm256_set1_epi32(int32(0xFF000000u));
+		/* 16 bit words of each pixel's alpha, repeated over the pixel */
+		const __m256i broadcast = _mm256_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15,
+			6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+		auto premultiply = [&](__m256i color) DT_TARGET_AVX2
+		{
+			__m256i x = _mm256_add_epi16(_mm256_mullo_epi16(color, _mm256_shuffle_epi8(color, broadcast)), bias);
+			return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+		};
+
+		uint64 i = 0u;
+		for (; i + 8u <= pixelCount; i += 8u)
+		{
+			__m256i* address = (__m256i*)(pixels + i * 4u);
+			__m256i bytes = _mm256_loadu_si256(address);
+			/* unpack and pack pair up within each lane, so the pixel order survives */
+			__m256i result = _mm256_packus_epi16(premultiply(_mm256_unpacklo_epi8(bytes, zero)), premultiply(_mm256_unpackhi_epi8(bytes, zero)));
+			_mm256_storeu_si256(address, _mm256_blendv_epi8(result, bytes, alphaMask));
+		}
+		PremultiplyAlphaSSE2(pixels + i * 4u, pixelCount - i);
+	}
+
+	DT_TARGET_AVX2 static void SwapRedBlueAVX2(const uint8* source, uint8* destination, uint64 pixelCount)
+	{
+		const __m256i order = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+			2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+		uint64 i = 0u;
+		for (; i + 8u <= pixelCount; i += 8u)
+		{
+			__m256i pixel = _mm256_loadu_si256((const __m256i*)(source + i * 4u));
+			_mm256_storeu_si256((__m256i*)(destination + i * 4u), _mm256_shuffle_epi8(pixel, order));
+		}
+		SwapRedBlueSSE2(source + i * 4u, destination + i * 4u, pixelCount - i);
+	}
+
+	static bool HasAVX2()
+	{
+		uint32 registers[4] = {};
+	#if defined(_MSC_VER)
+		__cpuid((int*)registers, 0);
+		if (registers[0] < 7u)
+			return false;
+		__cpuid((int*)registers, 1);
+	#else
+		if (__get_cpuid_max(0u, nullptr) < 7u)
+			return false;
+		__cpuid(1u, registers[0], registers[1], registers[2], registers[3]);
+	#endif
+		/* the OS has to save the ymm registers on a context switch: OSXSAVE, then XCR0 bits 1 and 2 */
+		if ((registers[2] & Bit(27u)) == 0u)
+			return false;
+	#if defined(_MSC_VER)
+		uint64 enabledState = _xgetbv(0u);
+	#else
+		uint32 low, high;
+		__asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0u));
+		uint64 enabledState = (uint64(high) << 32u) | low;
+	#endif
+		if ((enabledState & 6u) != 6u)
+			return false;
+
+	#if defined(_MSC_VER)
+		__cpuidex((int*)registers, 7, 0);
+	#else
+		__cpuid_count(7u, 0u, registers[0], registers[1], registers[2], registers[3]);
+	#endif
+		return (registers[1] & Bit(5u)) != 0u;
+	}
+#endif
+
+	static const KernelTable s_Kernels[] =
+	{
+		{ DecodeRowScalar, EncodeRowScalar, FilterHorizontalScalar, FilterVerticalScalar, HalveScalar, PremultiplyAlphaScalar, SwapRedBlueScalar },
+	#if DT_IMAGE_SIMD
+		{ DecodeRowSSE2, EncodeRowSSE2, FilterHorizontalSSE2, FilterVerticalSSE2, HalveSSE2, PremultiplyAlphaSSE2, SwapRedBlueSSE2 },
+		{ DecodeRowAVX2, EncodeRowAVX2, FilterHorizontalSSE2, FilterVerticalAVX2, HalveSSE2, PremultiplyAlphaAVX2, SwapRedBlueAVX2 },
+	#endif
+	};
+
+	static SimdLevel DetectLevel()
+	{
+	#if DT_IMAGE_SIMD
+		return HasAVX2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+	#else
+		return SimdLevel::Scalar;
+	#endif
+	}
+
+	static const SimdLevel s_SupportedLevel = DetectLevel();
+	static SimdLevel s_Level = s_SupportedLevel;
+
+	static const KernelTable& GetKernels()
+	{
+		return s_Kernels[uint32(s_Level)];
+	}
+
+	SimdLevel ImageKernels::GetSupportedLevel()
+	{
+		return s_SupportedLevel;
+	}
+
+	SimdLevel ImageKernels::GetLevel()
+	{
+		return s_Level;
+	}
+
+	void ImageKernels::SetLevel(SimdLevel level)
+	{
+		s_Level = std::min(level, s_SupportedLevel);
+	}
+
+	const char* ImageKernels::GetLevelName(SimdLevel level)
+	{
+		switch (level)
+		{
+			case SimdLevel::Scalar: return "Scalar";
+			case SimdLevel::SSE2:   return "SSE2";
+			case SimdLevel::AVX2:   return "AVX2";
+		}
+		return "Unknown";
+	}
+
+	void ImageKernels::SrgbToLinear(const uint8* source, float* destination, uint64 pixelCount)
+	{
+		GetKernels().DecodeRow(source, destination, pixelCount, ImageColorSpace::Srgb);
+	}
+
+	void ImageKernels::LinearToSrgb(const float* source, uint8* destination, uint64 pixelCount)
+	{
+		GetKernels().EncodeRow(source, destination, pixelCount, ImageColorSpace::Srgb);
+	}
+
+	void ImageKernels::ToFloat(const uint8* source, float* destination, uint64 pixelCount, ImageColorSpace colorSpace)
+	{
+		GetKernels().DecodeRow(source, destination, pixelCount, colorSpace);
+	}
+
+	void ImageKernels::ToBytes(const float* source, uint8* destination, uint64 pixelCount, ImageColorSpace colorSpace)
+	{
+		GetKernels().EncodeRow(source, destination, pixelCount, colorSpace);
+	}
+
+	void ImageKernels::Halve(const float* source, uint32 sourceWidth, uint32 sourceHeight, float* destination)
+	{
+		GetKernels().Halve(source, sourceWidth, sourceHeight, destination);
+	}
+
+	void ImageKernels::PremultiplyAlpha(uint8* pixels, uint64 pixelCount)
+	{
+		GetKernels().PremultiplyAlpha(pixels, pixelCount);
+	}
+
+	void ImageKernels::SwapRedBlue(const uint8* source, uint8* destination, uint64 pixelCount)
+	{
+		GetKernels().SwapRedBlue(source, destination, pixelCount);
+	}
+
+	/* tent of radius 1 output pixel, measured in source pixels: bilinear when magnifying, a box-like average when minifying */
+	static FilterAxis BuildFilterAxis(uint32 sourceSize, uint32 size)
+	{
+		FilterAxis axis;
+		axis.Start.resize(size);
+		axis.Count.resize(size);
+
+		double scale = double(size) / double(sourceSize);
+		double radius = scale < 1.0 ? 1.0 / scale : 1.0;
+		std::vector<std::vector<double>> taps(size);
+		for (uint32 x = 0u; x < size; x++)
+		{
+			double center = (x + 0.5) / scale;
+			int64 first = int64(std::floor(center - radius));
+			int64 last = int64(std::ceil(center + radius));
+			int64 clampedFirst = std::clamp<int64>(first, 0, sourceSize - 1);
+			int64 clampedLast = std::clamp<int64>(last, 0, sourceSize - 1);
+
+			std::vector<double>& weights = taps[x];
+			weights.assign(size_t(clampedLast - clampedFirst + 1), 0.0);
+			double total = 0.0;
+			for (int64 i = first; i <= last; i++)
+			{
+				double weight = 1.0 - std::abs(i + 0.5 - center) / radius;
+				if (weight <= 0.0)
+					continue;
+				weights[size_t(std::clamp<int64>(i, 0, sourceSize - 1) - clampedFirst)] += weight;
+				total += weight;
+			}
+
+			/* drop the zero taps at either end so Count is the real filter width */
+			size_t begin = 0u, end = weights.size();
+			while (begin + 1u < end && weights[begin] == 0.0)
+				begin++;
+			while (end - 1u > begin && weights[end - 1u] == 0.0)
+				end--;
+			for (double& weight : weights)
+				weight /= total;
+			weights = std::vector<double>(weights.begin() + begin, weights.begin() + end);
+
+			axis.Start[x] = uint32(clampedFirst + int64(begin));
+			axis.Count[x] = uint32(weights.size());
+			axis.MaxTaps = std::max(axis.MaxTaps, axis.Count[x]);
+		}
+
+		axis.Weights.assign(uint64(size) * axis.MaxTaps, 0.0f);
+		for (uint32 x = 0u; x < size; x++)
+			for (uint32 j = 0u; j < axis.Count[x]; j++)
+				axis.Weights[uint64(x) * axis.MaxTaps + j] = float(taps[x][j]);
+		return axis;
+	}
+
+	void ImageKernels::Resize(const uint8* source, uint32 sourceWidth, uint32 sourceHeight, uint64 sourcePitch,
+		uint8* destination, uint32 width, uint32 height, uint64 pitch, ImageColorSpace colorSpace)
+	{
+		if (sourceWidth == 0u || sourceHeight == 0u || width == 0u || height == 0u)
+			return;
+
+		const KernelTable& kernels = GetKernels();
+		FilterAxis horizontal = BuildFilterAxis(sourceWidth, width);
+		FilterAxis vertical = BuildFilterAxis(sourceHeight, height);
+
+		/* horizontally filtered source rows, each computed once and kept while the vertical window covers it */
+		uint32 ringSize = vertical.MaxTaps;
+		uint64 rowFloats = uint64(width) * 4u;
+		std::vector<float> ring(ringSize * rowFloats);
+		std::vector<int64> ringRows(ringSize, -1);
+		std::vector<float> decoded(uint64(sourceWidth) * 4u);
+		std::vector<float> filtered(rowFloats);
+		std::vector<const float*> rows(ringSize);
+
+		for (uint32 y = 0u; y < height; y++)
+		{
+			for (uint32 j = 0u; j < vertical.Count[y]; j++)
+			{
+				uint32 row = vertical.Start[y] + j;
+				uint32 slot = row % ringSize;
+				float* slotData = &ring[slot * rowFloats];
+				if (ringRows[slot] != int64(row))
+				{
+					kernels.DecodeRow(source + row * sourcePitch, decoded.data(), sourceWidth, colorSpace);
+					kernels.FilterHorizontal(decoded.data(), slotData, horizontal);
+					ringRows[slot] = row;
+				}
+				rows[j] = slotData;
+			}
+
+			kernels.FilterVertical(rows.data(), &vertical.Weights[uint64(y) * vertical.MaxTaps], vertical.Count[y], filtered.data(), rowFloats);
+			kernels.EncodeRow(filtered.data(), destination + y * pitch, width, colorSpace);
+		}
+	}
+
+	bool ImageKernels::ResizeReference(const uint8* source, uint32 sourceWidth, uint32 sourceHeight, uint64 sourcePitch,
+		uint8* destination, uint32 width, uint32 height, uint64 pitch, ImageColorSpace colorSpace)
+	{
+		if (sourceWidth == 0u || sourceHeight == 0u || !SupportsResizeReference(sourceWidth, width) || !SupportsResizeReference(sourceHeight, height))
+			return false;
+
+		/* alpha as an ordinary channel (no alpha weighting), like the kernels */
+		stbir_colorspace space = colorSpace == ImageColorSpace::Srgb ? STBIR_COLORSPACE_SRGB : STBIR_COLORSPACE_LINEAR;
+		stbir_resize_uint8_generic(source, int(sourceWidth), int(sourceHeight), int(sourcePitch),
+			destination, int(width), int(height), int(pitch), 4, 3, STBIR_FLAG_ALPHA_PREMULTIPLIED,
+			STBIR_EDGE_CLAMP, STBIR_FILTER_TRIANGLE, space, nullptr);
+		return true;
+	}
+}
\ No newline at end of file
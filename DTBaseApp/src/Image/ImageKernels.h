@@ -0,0 +1,62 @@
+#pragma once
+#include "Core/Core.h"
+
+namespace DT
+{
+	enum class SimdLevel : uint8
+	{
+		Scalar,
+		SSE2,
+		AVX2
+	};
+
+	enum class ImageColorSpace : uint8
+	{
+		Linear, // channels are proportional to light and filtered as they are
+		Srgb    // color channels are sRGB encoded and filtered in linear light, alpha is always linear
+	};
+
+	/*
+		kernels over tightly packed RGBA8 pixels, compiled for every instruction set and dispatched to the best
+		one the CPU supports. All levels give bit identical results: same summation order and no FMA
+	*/
+	class ImageKernels
+	{
+	public:
+		static SimdLevel GetSupportedLevel();
+		static SimdLevel GetLevel();
+		/* clamped to the supported level, for benchmarks and validation */
+		static void SetLevel(SimdLevel level);
+		static const char* GetLevelName(SimdLevel level);
+
+		/* 4 floats in [0, 1] per pixel */
+		static void SrgbToLinear(const uint8* source, float* destination, uint64 pixelCount);
+		static void LinearToSrgb(const float* source, uint8* destination, uint64 pixelCount);
+		/* as above, color channels only go through the sRGB curve when colorSpace is Srgb */
+		static void ToFloat(const uint8* source, float* destination, uint64 pixelCount, ImageColorSpace colorSpace);
+		static void ToBytes(const float* source, uint8* destination, uint64 pixelCount, ImageColorSpace colorSpace);
+
+		/* 2x2 box over tightly packed float RGBA: sizes halve rounding down but stay >= 1, an odd edge folds into the last pixel */
+		static void Halve(const float* source, uint32 sourceWidth, uint32 sourceHeight, float* destination);
+		static uint32 GetHalvedSize(uint32 size) { return std::max(size / 2u, 1u); }
+
+		static void PremultiplyAlpha(uint8* pixels, uint64 pixelCount);
+		/* RGBA <-> BGRA, source may equal destination */
+		static void SwapRedBlue(const uint8* source, uint8* destination, uint64 pixelCount);
+
+		/* separable triangle filter, widened when minifying so every source pixel contributes */
+		static void Resize(const uint8* source, uint32 sourceWidth, uint32 sourceHeight, uint64 sourcePitch,
+			uint8* destination, uint32 width, uint32 height, uint64 pitch, ImageColorSpace colorSpace);
+		/*
+			stb_image_resize with the same filter and edge mode: the reference the kernels are checked against.
+			stb asserts on its own triangle weights when an axis shrinks by less than half, so every axis must keep
+			its size, grow, or at least halve (size * 2 <= sourceSize); returns false and leaves destination alone otherwise
+		*/
+		static bool SupportsResizeReference(uint32 sourceSize, uint32 size)
+		{
+			return size != 0u && (size >= sourceSize || uint64(size) * 2u <= sourceSize);
+		}
+		static bool ResizeReference(const uint8* source, uint32 sourceWidth, uint32 sourceHeight, uint64 sourcePitch,
+			uint8* destination, uint32 width, uint32 height, uint64 pitch, ImageColorSpace colorSpace);
+	};
+}
\ No newline at end of file
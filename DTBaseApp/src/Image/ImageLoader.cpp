@@ -0,0 +1,260 @@
+#include "ImageLoader.h"
+#include "ImageDiskCache.h"
+#include "Core/Profiler.h"
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace DT
+{
+	struct ImageRequest
+	{
+		std::filesystem::path Path;
+		std::string Key;
+		std::atomic<ImageState> State = ImageState::Pending;
+		Image Pixels;       // written once, before State leaves Pending
+		JobCounter Counter;
+
+		bool Cached = false;
+		std::list<ImageRequest*>::iterator RecentPosition;
+	};
+
+	struct ImageLoaderState
+	{
+		std::mutex Mutex;
+		std::unordered_map<std::string, std::shared_ptr<ImageRequest>> Requests; // pending and cached
+		std::list<ImageRequest*> Recent; // cached only, most recently requested first
+
+		ImageLoaderSpecification Specification;
+		ImageLoader::Statistics Statistics;
+	};
+
+	static ImageLoaderState* s_State = nullptr;
+
+	/*
+		the counter is raised by Submit after the request became visible to other threads and lowered after
+		the state is final, so both are checked: the request may be released as soon as this returns
+	*/
+	static void WaitForRequest(ImageRequest& request)
+	{
+		while (request.State.load(std::memory_order_acquire) == ImageState::Pending || !request.Counter.IsDone())
+		{
+			JobSystem::Wait(request.Counter);
+			if (request.State.load(std::memory_order_acquire) == ImageState::Pending)
+				std::this_thread::yield();
+		}
+	}
+
+	ImageState ImageHandle::GetState() const
+	{
+		return m_Request ? m_Request->State.load(std::memory_order_acquire) : ImageState::Failed;
+	}
+
+	const Image* ImageHandle::Get() const
+	{
+		return IsReady() ? &m_Request->Pixels : nullptr;
+	}
+
+	const Image* ImageHandle::Wait() const
+	{
+		if (!m_Request)
+			return nullptr;
+
+		WaitForRequest(*m_Request);
+		return Get();
+	}
+
+	const std::filesystem::path& ImageHandle::GetPath() const
+	{
+		static const std::filesystem::path s_EmptyPath;
+		return m_Request ? m_Request->Path : s_EmptyPath;
+	}
+
+	void ImageLoader::Init(const ImageLoaderSpecification& specification)
+	{
+		s_State = new ImageLoaderState;
+		s_State->Specification = specification;
+	}
+
+	void ImageLoader::Shutdown()
+	{
+		if (!s_State)
+			return;
+
+		std::vector<std::shared_ptr<ImageRequest>> pending;
+		{
+			std::lock_guard<std::mutex> lock(s_State->Mutex);
+			for (const auto& [key, request] : s_State->Requests)
+			{
+				if (request->State.load(std::memory_order_acquire) == ImageState::Pending)
+					pending.push_back(request);
+			}
+		}
+		for (const std::shared_ptr<ImageRequest>& request : pending)
+			WaitForRequest(*request);
+
+		const Statistics& statistics = s_State->Statistics;
+		if (statistics.Requests > 0u)
+			LOG_TRACE("Image loader: {} requests, {} cache hits, {} decoded ({} from disk cache), {} failed, {} evicted",
+				statistics.Requests, statistics.CacheHits, statistics.Decoded, statistics.DiskCacheHits, statistics.Failed, statistics.Evicted);
+
+		delete s_State;
+		s_State = nullptr;
+	}
+
+	ImageHandle ImageLoader::Load(const std::filesystem::path& filePath)
+	{
+		std::shared_ptr<ImageRequest> request = std::make_shared<ImageRequest>();
+		request->Path = filePath;
+		request->Key = filePath.lexically_normal().generic_string();
+
+		if (!s_State)
+		{
+			DecodeJob(request.get(), 0u, 1u);
+			return ImageHandle(std::move(request));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_State->Mutex);
+			s_State->Statistics.Requests++;
+
+			auto [it, inserted] = s_State->Requests.try_emplace(request->Key, request);
+			if (!inserted && it->second->State.load(std::memory_order_acquire) == ImageState::Failed && it->second->Counter.IsDone())
+			{
+				/* failures are not cached: the file may have been fixed or created since */
+				it->second = request;
+				inserted = true;
+			}
+
+			if (!inserted)
+			{
+				ImageRequest& existing = *it->second;
+				if (existing.Cached)
+					s_State->Recent.splice(s_State->Recent.begin(), s_State->Recent, existing.RecentPosition);
+
+				s_State->Statistics.CacheHits++;
+				return ImageHandle(it->second);
+			}
+		}
+
+		if (JobSystem::GetWorkerCount() == 0u)
+			DecodeJob(request.get(), 0u, 1u);
+		else
+			JobSystem::Submit({ &ImageLoader::DecodeJob, request.get(), 0u, 1u, &request->Counter });
+
+		return ImageHandle(std::move(request));
+	}
+
+	void ImageLoader::Trim()
+	{
+		if (!s_State)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_State->Mutex);
+
+		uint64 budget = s_State->Specification.CacheBudget;
+		s_State->Specification.CacheBudget = 0u;
+		EvictOverBudget();
+		s_State->Specification.CacheBudget = budget;
+	}
+
+	void ImageLoader::SetCacheBudget(uint64 bytes)
+	{
+		/* without Init nothing is cached */
+		if (!s_State)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_State->Mutex);
+		s_State->Specification.CacheBudget = bytes;
+		EvictOverBudget();
+	}
+
+	ImageLoader::Statistics ImageLoader::GetStatistics()
+	{
+		if (!s_State)
+			return {};
+
+		std::lock_guard<std::mutex> lock(s_State->Mutex);
+		return s_State->Statistics;
+	}
+
+	void ImageLoader::DecodeJob(void* userData, uint32 begin, uint32 end)
+	{
+		PROFILE_SCOPE("DecodeImage");
+
+		ImageRequest& request = *static_cast<ImageRequest*>(userData);
+
+		bool diskCache = s_State && s_State->Specification.DiskCache;
+		if (diskCache)
+		{
+			if (Image cached = ImageDiskCache::Read(request.Path); cached.IsValid())
+			{
+				OnDecoded(request, std::move(cached), true);
+				return;
+			}
+		}
+
+		Image image = Image::Load(request.Path);
+		if (diskCache && image.IsValid())
+			ImageDiskCache::Write(request.Path, image);
+		OnDecoded(request, std::move(image), false);
+	}
+
+	void ImageLoader::OnDecoded(ImageRequest& request, Image&& image, bool fromDiskCache)
+	{
+		bool valid = image.IsValid();
+		request.Pixels = std::move(image);
+
+		if (!s_State)
+		{
+			request.State.store(valid ? ImageState::Ready : ImageState::Failed, std::memory_order_release);
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(s_State->Mutex);
+		request.State.store(valid ? ImageState::Ready : ImageState::Failed, std::memory_order_release);
+
+		Statistics& statistics = s_State->Statistics;
+		if (!valid)
+		{
+			statistics.Failed++;
+			return;
+		}
+
+		statistics.Decoded++;
+		statistics.DiskCacheHits += fromDiskCache ? 1u : 0u;
+		statistics.CachedBytes += request.Pixels.GetSize();
+		statistics.CachedImages++;
+
+		request.Cached = true;
+		s_State->Recent.push_front(&request);
+		request.RecentPosition = s_State->Recent.begin();
+		EvictOverBudget();
+	}
+
+	void ImageLoader::EvictOverBudget()
+	{
+		Statistics& statistics = s_State->Statistics;
+		for (auto it = s_State->Recent.end(); it != s_State->Recent.begin() && statistics.CachedBytes > s_State->Specification.CacheBudget;)
+		{
+			--it;
+
+			/*
+				the map owns one reference: more means a handle is alive and its pixels would not be freed.
+				the job system still touches the counter of a decode that just finished, keep it until then
+			*/
+			ImageRequest& request = **it;
+			auto entry = s_State->Requests.find(request.Key);
+			if (entry->second.use_count() > 1 || !request.Counter.IsDone())
+				continue;
+
+			statistics.CachedBytes -= request.Pixels.GetSize();
+			statistics.CachedImages--;
+			statistics.Evicted++;
+
+			it = s_State->Recent.erase(it);
+			s_State->Requests.erase(entry);
+		}
+	}
+}
\ No newline at end of file
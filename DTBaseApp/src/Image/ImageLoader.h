@@ -0,0 +1,84 @@
+#pragma once
+#include "Image.h"
+#include "Core/JobSystem.h"
+
+namespace DT
+{
+	enum class ImageState : uint8
+	{
+		Pending,
+		Ready,
+		Failed
+	};
+
+	struct ImageLoaderSpecification
+	{
+		uint64 CacheBudget = 256ull << 20u; // bytes of decoded pixels, images that still have handles are never evicted
+		bool DiskCache = true;              // map .dtimg files instead of decoding, write them after a decode
+	};
+
+	struct ImageRequest;
+
+	/* shared reference to a requested image, cheap to copy; all methods are safe from any thread */
+	class ImageHandle
+	{
+	public:
+		ImageHandle() = default;
+
+		bool IsValid() const { return m_Request != nullptr; }
+		ImageState GetState() const;
+		bool IsDone() const { return GetState() != ImageState::Pending; }
+		bool IsReady() const { return GetState() == ImageState::Ready; }
+
+		/* nullptr until the image is ready */
+		const Image* Get() const;
+		/* runs jobs on the calling thread until the decode is done, nullptr if it failed */
+		const Image* Wait() const;
+
+		const std::filesystem::path& GetPath() const;
+	private:
+		ImageHandle(std::shared_ptr<ImageRequest> request)
+			: m_Request(std::move(request)) {}
+	private:
+		std::shared_ptr<ImageRequest> m_Request;
+
+		friend class ImageLoader;
+	};
+
+	/*
+		decodes images on the job system. Requests for a path that is pending or cached share one decode,
+		finished images stay cached (least recently requested evicted first) within the memory budget
+	*/
+	class ImageLoader
+	{
+	public:
+		struct Statistics
+		{
+			uint64 Requests = 0u;
+			uint64 CacheHits = 0u;  // includes requests that joined a pending decode
+			uint64 Decoded = 0u;    // includes the images mapped from the disk cache
+			uint64 DiskCacheHits = 0u;
+			uint64 Failed = 0u;
+			uint64 Evicted = 0u;
+			uint64 CachedBytes = 0u;
+			uint32 CachedImages = 0u;
+		};
+	public:
+		static void Init(const ImageLoaderSpecification& specification = {});
+		/* waits for the pending decodes, call before the job system shuts down */
+		static void Shutdown();
+
+		/* never blocks when the job system has workers, otherwise decodes on the calling thread */
+		static ImageHandle Load(const std::filesystem::path& filePath);
+
+		/* drops every cached image that no handle refers to */
+		static void Trim();
+
+		static void SetCacheBudget(uint64 bytes);
+		static Statistics GetStatistics();
+	private:
+		static void DecodeJob(void* userData, uint32 begin, uint32 end);
+		static void OnDecoded(ImageRequest& request, Image&& image, bool fromDiskCache);
+		static void EvictOverBudget();
+	};
+}
\ No newline at end of file
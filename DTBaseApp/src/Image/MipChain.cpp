@@ -0,0 +1,134 @@
+#include "MipChain.h"
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+
+namespace DT
+{
+	uint32 MipChain::GetFullLevelCount(uint32 width, uint32 height)
+	{
+		uint32 count = 1u;
+		for (uint32 size = std::max(width, height); size > 1u; size /= 2u)
+			count++;
+		return count;
+	}
+
+	uint64 MipChain::GetSize() const
+	{
+		uint64 size = 0u;
+		for (const Image& level : m_Levels)
+			size += level.GetSize();
+		return size;
+	}
+
+	/* writes a block of float pixels into a level at (x, y) */
+	static void StoreBlock(const float* pixels, uint32 width, uint32 height, Image& level, uint32 x, uint32 y, ImageColorSpace colorSpace)
+	{
+		for (uint32 row = 0u; row < height; row++)
+			ImageKernels::ToBytes(pixels + uint64(row) * width * 4u, level.GetRow(y + row) + uint64(x) * Image::Channels, width, colorSpace);
+	}
+
+	MipChain MipChain::Generate(const Image& source, const MipChainSpecification& specification)
+	{
+		PROFILE_FUNCTION();
+
+		MipChain chain;
+		if (!source.IsValid())
+			return chain;
+
+		uint32 levelCount = GetFullLevelCount(source.GetWidth(), source.GetHeight());
+		if (specification.MaxLevelCount > 0u)
+			levelCount = std::min(levelCount, specification.MaxLevelCount);
+
+		chain.m_Levels.reserve(levelCount);
+		chain.m_Levels.push_back(source);
+		for (uint32 level = 1u, width = source.GetWidth(), height = source.GetHeight(); level < levelCount; level++)
+		{
+			width = ImageKernels::GetHalvedSize(width);
+			height = ImageKernels::GetHalvedSize(height);
+			chain.m_Levels.emplace_back(width, height);
+		}
+		if (levelCount == 1u)
+			return chain;
+
+		/*
+			tiles start on multiples of the tile size, the last one in a row or column also takes the remainder
+			(up to twice the size). Starts stay even on every level above tileLevel, so each tile halves on its own
+		*/
+		uint32 tileSize = std::max(specification.TileSize, 2u);
+		ASSERT((tileSize & (tileSize - 1u)) == 0u);
+		uint32 tilesX = std::max(source.GetWidth() / tileSize, 1u);
+		uint32 tilesY = std::max(source.GetHeight() / tileSize, 1u);
+		uint32 tileCount = tilesX * tilesY;
+
+		uint32 tileLevel = levelCount - 1u;
+		if (tileCount > 1u)
+			tileLevel = std::min(tileLevel, GetFullLevelCount(tileSize, 1u) - 1u);
+
+		/* float copy of tileLevel, the input of the levels below it */
+		const Image& topImage = chain.m_Levels[tileLevel];
+		std::vector<float> top;
+		if (tileLevel + 1u < levelCount)
+			top.resize(uint64(topImage.GetWidth()) * topImage.GetHeight() * 4u);
+
+		ImageColorSpace colorSpace = specification.ColorSpace;
+		std::vector<Image>& levels = chain.m_Levels;
+		auto processTiles = [&](uint32 begin, uint32 end)
+		{
+			PROFILE_SCOPE("MipChainTiles");
+			std::vector<float> current, next;
+			for (uint32 tile = begin; tile < end; tile++)
+			{
+				uint32 tileX = tile % tilesX, tileY = tile / tilesX;
+				uint32 x = tileX * tileSize, y = tileY * tileSize;
+				uint32 width = tileX + 1u == tilesX ? source.GetWidth() - x : tileSize;
+				uint32 height = tileY + 1u == tilesY ? source.GetHeight() - y : tileSize;
+
+				/* the only read of the source */
+				current.resize(uint64(width) * height * 4u);
+				for (uint32 row = 0u; row < height; row++)
+					ImageKernels::ToFloat(source.GetRow(y + row) + uint64(x) * Image::Channels, current.data() + uint64(row) * width * 4u, width, colorSpace);
+
+				for (uint32 level = 1u; level <= tileLevel; level++)
+				{
+					uint32 nextWidth = ImageKernels::GetHalvedSize(width);
+					uint32 nextHeight = ImageKernels::GetHalvedSize(height);
+					next.resize(uint64(nextWidth) * nextHeight * 4u);
+					ImageKernels::Halve(current.data(), width, height, next.data());
+					std::swap(current, next);
+					width = nextWidth;
+					height = nextHeight;
+					x /= 2u;
+					y /= 2u;
+					StoreBlock(current.data(), width, height, levels[level], x, y, colorSpace);
+				}
+
+				if (!top.empty())
+				{
+					for (uint32 row = 0u; row < height; row++)
+					{
+						const float* from = current.data() + uint64(row) * width * 4u;
+						std::copy(from, from + uint64(width) * 4u, top.data() + (uint64(y + row) * topImage.GetWidth() + x) * 4u);
+					}
+				}
+			}
+		};
+		/* row major, so neighbouring tiles (and the workers taking them) walk the source in address order */
+		JobSystem::ParallelFor(tileCount, 1u, processTiles);
+
+		/* what is left is at most (source / tile size) pixels on a side */
+		uint32 width = topImage.GetWidth(), height = topImage.GetHeight();
+		std::vector<float> next;
+		for (uint32 level = tileLevel + 1u; level < levelCount; level++)
+		{
+			uint32 nextWidth = ImageKernels::GetHalvedSize(width);
+			uint32 nextHeight = ImageKernels::GetHalvedSize(height);
+			next.resize(uint64(nextWidth) * nextHeight * 4u);
+			ImageKernels::Halve(top.data(), width, height, next.data());
+			std::swap(top, next);
+			width = nextWidth;
+			height = nextHeight;
+			StoreBlock(top.data(), width, height, levels[level], 0u, 0u, colorSpace);
+		}
+		return chain;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include "Image.h"
+
+namespace DT
+{
+	struct MipChainSpecification
+	{
+		ImageColorSpace ColorSpace = ImageColorSpace::Srgb;
+		uint32 TileSize = 128u;     // power of two, a tile in floats (TileSize^2 * 16 bytes) should stay in L2
+		uint32 MaxLevelCount = 0u;  // 0 = down to 1x1
+	};
+
+	/*
+		level 0 is the source image (sharing its pixels), every next level halves it with a 2x2 box in linear light.
+		Tiles of the source are read once and carried down all their levels on the job system while still in cache,
+		the levels smaller than a tile are finished from the gathered float pixels on the calling thread
+	*/
+	class MipChain
+	{
+	public:
+		MipChain() = default;
+
+		static MipChain Generate(const Image& source, const MipChainSpecification& specification = {});
+		static uint32 GetFullLevelCount(uint32 width, uint32 height);
+
+		bool IsValid() const { return !m_Levels.empty(); }
+		uint32 GetLevelCount() const { return uint32(m_Levels.size()); }
+		const Image& GetLevel(uint32 level) const { return m_Levels[level]; }
+		const std::vector<Image>& GetLevels() const { return m_Levels; }
+		/* bytes of all levels, level 0 included */
+		uint64 GetSize() const;
+	private:
+		std::vector<Image> m_Levels;
+	};
+}
\ No newline at end of file
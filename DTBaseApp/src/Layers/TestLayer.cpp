@@ -3,6 +3,12 @@
 
 namespace DT
 {
+	TestLayer::TestLayer()
+		: Layer("TestLayer")
+	{
+		SetEventInterest(Event::CategoryNone, EventHandlers::TypeMask);
+	}
+
 	void TestLayer::OnAttach()
 	{
 		LOG_TRACE("Attached!");
@@ -14,97 +20,106 @@ namespace DT
 
 	void TestLayer::OnEvent(Event& event)
 	{
-		Event::Dispatcher dispatcher(event);
-		dispatcher.Dispatch<KeyPressedEvent>([&](KeyPressedEvent& key)
+		EventHandlers::Dispatch(*this, event);
+	}
+
+	bool TestLayer::OnKeyPressed(KeyPressedEvent& key)
+	{
+		switch (key.GetKeyCode())
 		{
-			switch (key.GetKeyCode())
+			case Key::M:
 			{
-				case Key::M:
-				{
-					Application::Get().GetWindow().Maximize();
-					break;
-				}
-				case Key::F:
-				{
-					static bool windowed = true;
-					if (windowed)
-						Application::Get().GetWindow().ToFullscreen();
-					else
-						Application::Get().GetWindow().ToWindowed();
-					windowed = !windowed;
-					break;
-				}
-				case Key::A:
-				{
-					static bool fixed = false;
-					fixed = !fixed;
-					if (fixed)
-						Application::Get().GetWindow().SetFixedAspectRatio(16, 9);
-					else
-						Application::Get().GetWindow().SetFixedAspectRatio(-1, -1);
-					break;
-				}
-				case Key::C:
-				{
-					Application::Get().GetWindow().SetMousePosition(200, 200);
-					break;
-				}
-				case Key::U:
-				{
-					LOG_TRACE(Application::Get().GetWindow().GetClipboardString());
-					break;
-				}
-				case Key::Up:
-				{
-					m_Opacity += 0.1f;
-					m_Opacity = std::clamp(m_Opacity, 0.0f, 1.0f);
-					Application::Get().GetWindow().SetOpacity(m_Opacity);
-					break;
-				}
-				case Key::Down:
-				{
-					m_Opacity -= 0.1f;
-					m_Opacity = std::clamp(m_Opacity, 0.0f, 1.0f);
-					Application::Get().GetWindow().SetOpacity(m_Opacity);
-					break;
-				}
-				case Key::T:
-				{
-					Application::Get().GetWindow().SetTitle("New title!");
-					break;
-				}
-				case Key::D:
-				{
-					static bool decorated = true;
-					decorated = !decorated;
-					Application::Get().GetWindow().SetDecorated(decorated);
-					break;
-				}
-				case Key::R:
-				{
-					static bool resizable = true;
-					resizable = !resizable;
-					Application::Get().GetWindow().SetResizable(resizable);
-					break;
-				}
-				case Key::S:
-				{
-					Application::Get().GetWindow().CenterWindow();
-					break;
-				}
-				case Key::N:
-				{
-					Application::Get().GetWindow().SetSizeLimits(200, 200, 500, 300);
-					break;
-				}
+				Application::Get().GetWindow().Maximize();
+				break;
 			}
-			return false;
-		});
-		dispatcher.Dispatch<WindowFocusEvent>([](WindowFocusEvent& e) 
-		{
-			LOG_TRACE("Window focused? {}", e.IsFocused());
-			return false;
-		});
+			case Key::F:
+			{
+				static bool windowed = true;
+				if (windowed)
+					Application::Get().GetWindow().ToFullscreen();
+				else
+					Application::Get().GetWindow().ToWindowed();
+				windowed = !windowed;
+				break;
+			}
+			case Key::A:
+			{
+				static bool fixed = false;
+				fixed = !fixed;
+				if (fixed)
+					Application::Get().GetWindow().SetFixedAspectRatio(16, 9);
+				else
+					Application::Get().GetWindow().SetFixedAspectRatio(-1, -1);
+				break;
+			}
+			case Key::C:
+			{
+				Application::Get().GetWindow().SetMousePosition(200, 200);
+				break;
+			}
+			case Key::U:
+			{
+				LOG_TRACE("{}", Application::Get().GetWindow().GetClipboardString());
+				break;
+			}
+			case Key::Up:
+			{
+				m_Opacity += 0.1f;
+				m_Opacity = std::clamp(m_Opacity, 0.0f, 1.0f);
+				Application::Get().GetWindow().SetOpacity(m_Opacity);
+				break;
+			}
+			case Key::Down:
+			{
+				m_Opacity -= 0.1f;
+				m_Opacity = std::clamp(m_Opacity, 0.0f, 1.0f);
+				Application::Get().GetWindow().SetOpacity(m_Opacity);
+				break;
+			}
+			case Key::T:
+			{
+				Application::Get().GetWindow().SetTitle("New title!");
+				break;
+			}
+			case Key::D:
+			{
+				static bool decorated = true;
+				decorated = !decorated;
+				Application::Get().GetWindow().SetDecorated(decorated);
+				break;
+			}
+			case Key::R:
+			{
+				static bool resizable = true;
+				resizable = !resizable;
+				Application::Get().GetWindow().SetResizable(resizable);
+				break;
+			}
+			case Key::S:
+			{
+				Application::Get().GetWindow().CenterWindow();
+				break;
+			}
+			case Key::N:
+			{
+				Application::Get().GetWindow().SetSizeLimits(200, 200, 500, 300);
+				break;
+			}
+			case Key::I:
+			{
+				Window& window = Application::Get().GetWindow();
+				window.SetRawMouseInput(!window.IsRawMouseInput());
+				LOG_TRACE("Raw mouse input {}", window.IsRawMouseInput() ? "on" : "off");
+				break;
+			}
+		}
+		return false;
+	}
+
+	bool TestLayer::OnWindowFocus(WindowFocusEvent& e)
+	{
+		LOG_TRACE("Window focused? {}", e.IsFocused());
+		return false;
 	}
 
 	void TestLayer::OnDetach()
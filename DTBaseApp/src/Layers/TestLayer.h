@@ -1,15 +1,23 @@
 #pragma once
 #include "Core/Layer.h"
+#include "Core/EventDispatchTable.h"
 
 namespace DT
 {
 	class TestLayer : public Layer
 	{
 	public:
+		TestLayer();
+
 		virtual void OnAttach() override;
 		virtual void OnUpdate(float dt) override;
 		virtual void OnEvent(Event& event) override;
 		virtual void OnDetach() override;
+	private:
+		bool OnKeyPressed(KeyPressedEvent& key);
+		bool OnWindowFocus(WindowFocusEvent& e);
+
+		using EventHandlers = EventDispatchTable<&TestLayer::OnKeyPressed, &TestLayer::OnWindowFocus>;
 	private:
 		float m_Opacity = 1.0f;
 	};
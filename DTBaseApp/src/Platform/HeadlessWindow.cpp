@@ -0,0 +1,302 @@
+#include "HeadlessWindow.h"
+#include <fstream>
+
+namespace DT
+{
+	/*
+		script format, one event per line ('#' starts a comment):
+			<frame> resize <width> <height>
+			<frame> focus <0|1>
+			<frame> close
+			<frame> key_press <key> [repeat]
+			<frame> key_release <key>
+			<frame> key_type <codepoint>
+			<frame> mouse_press <button>
+			<frame> mouse_release <button>
+			<frame> mouse_move <x> <y>
+			<frame> scroll <deltaX> <deltaY>
+			<frame> mouse_raw <deltaX> <deltaY>   (one raw sample, delivered even when raw input is off)
+	*/
+	static bool ParseScriptCommand(const std::string& command, Event::Type& type)
+	{
+		static const std::pair<const char*, Event::Type> commands[] =
+		{
+			{ "resize"       , Event::Type::WindowResize        },
+			{ "focus"        , Event::Type::WindowFocus         },
+			{ "close"        , Event::Type::WindowClosed        },
+			{ "key_press"    , Event::Type::KeyPressed          },
+			{ "key_release"  , Event::Type::KeyReleased         },
+			{ "key_type"     , Event::Type::KeyTyped            },
+			{ "mouse_press"  , Event::Type::MouseButtonPressed  },
+			{ "mouse_release", Event::Type::MouseButtonReleased },
+			{ "mouse_move"   , Event::Type::MouseMoved          },
+			{ "scroll"       , Event::Type::MouseScrolled       },
+			{ "mouse_raw"    , Event::Type::MouseRawInput       }
+		};
+
+		for (const auto& [name, commandType] : commands)
+		{
+			if (command == name)
+			{
+				type = commandType;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	HeadlessWindow::HeadlessWindow(const WindowSpecification& specification)
+		: m_Specification(specification)
+	{
+		m_WindowedWidth = (int32)m_Specification.Width;
+		m_WindowedHeight = (int32)m_Specification.Height;
+
+		WindowGeometry geometry;
+		geometry.Width = geometry.FramebufferWidth = m_WindowedWidth;
+		geometry.Height = geometry.FramebufferHeight = m_WindowedHeight;
+		geometry.DisplayResolution = s_DisplayResolution;
+		geometry.RefreshRate = 60;
+		m_Geometry.Store(geometry);
+
+		if (!m_Specification.HeadlessScriptPath.empty())
+			LoadScript(m_Specification.HeadlessScriptPath);
+
+		LOG_TRACE("Headless window {}x{}, {} scripted events", geometry.Width, geometry.Height, m_Script.size());
+	}
+
+	void HeadlessWindow::SetEventQueue(EventQueue* queue)
+	{
+		m_Queue = queue;
+	}
+
+	void HeadlessWindow::ProcessEvents()
+	{
+		BeginRawMouseFrame();
+		while (m_ScriptCursor < m_Script.size() && m_Script[m_ScriptCursor].Frame <= m_FrameIndex)
+			EmitEvent(m_Script[m_ScriptCursor++]);
+
+		if (m_Specification.HeadlessGenerator)
+		{
+			m_Generated.clear();
+			m_Specification.HeadlessGenerator(m_FrameIndex, m_Generated);
+			for (const SyntheticEvent& synthetic : m_Generated)
+				EmitEvent(synthetic);
+		}
+
+		if (!m_RawMouseSamples.empty())
+		{
+			auto [deltaX, deltaY] = GetRawMouseDelta();
+			PushEvent<MouseRawInputEvent>(deltaX, deltaY);
+		}
+
+		if (m_Specification.HeadlessFrameLimit != 0u && m_FrameIndex + 1u >= m_Specification.HeadlessFrameLimit)
+			PushEvent<WindowClosedEvent>();
+
+		m_FrameIndex++;
+	}
+
+	void HeadlessWindow::Maximize()
+	{
+		Resize(s_DisplayResolution.Width, s_DisplayResolution.Height);
+	}
+
+	void HeadlessWindow::ToFullscreen()
+	{
+		m_WindowedWidth = m_Geometry.Peek().Width;
+		m_WindowedHeight = m_Geometry.Peek().Height;
+		m_Geometry.Update([](WindowGeometry& geometry) { geometry.Fullscreen = true; });
+		Resize(s_DisplayResolution.Width, s_DisplayResolution.Height);
+	}
+
+	void HeadlessWindow::ToWindowed()
+	{
+		m_Geometry.Update([](WindowGeometry& geometry) { geometry.Fullscreen = false; });
+		Resize(m_WindowedWidth, m_WindowedHeight);
+	}
+
+	void HeadlessWindow::SetMousePosition(int32 x, int32 y)
+	{
+		m_Geometry.Update([x, y](WindowGeometry& geometry)
+		{
+			geometry.MouseX = x;
+			geometry.MouseY = y;
+		});
+	}
+
+	void HeadlessWindow::SetPosition(int32 x, int32 y)
+	{
+		m_Geometry.Update([x, y](WindowGeometry& geometry)
+		{
+			geometry.PositionX = x;
+			geometry.PositionY = y;
+		});
+	}
+
+	void HeadlessWindow::SetSize(int32 width, int32 height)
+	{
+		Resize(width, height);
+	}
+
+	bool HeadlessWindow::KeyIsPressed(KeyCode key) const
+	{
+		return key < m_KeyStates.size() && m_KeyStates.test(key);
+	}
+
+	bool HeadlessWindow::MouseIsPressed(MouseCode button) const
+	{
+		return button < m_MouseStates.size() && m_MouseStates.test(button);
+	}
+
+	void HeadlessWindow::LoadScript(const std::filesystem::path& scriptPath)
+	{
+		std::ifstream file(scriptPath);
+		if (!file)
+		{
+			LOG_ERROR("Could not open headless script {}", scriptPath.string());
+			return;
+		}
+
+		std::string line;
+		uint32 lineNumber = 0u;
+		while (std::getline(file, line))
+		{
+			lineNumber++;
+			if (size_t comment = line.find('#'); comment != std::string::npos)
+				line.erase(comment);
+
+			std::istringstream iss(line);
+			SyntheticEvent synthetic;
+			std::string command;
+			if (!(iss >> synthetic.Frame >> command))
+				continue;
+
+			if (!ParseScriptCommand(command, synthetic.Type))
+			{
+				LOG_WARN("{}({}): unknown headless command '{}'", scriptPath.string(), lineNumber, command);
+				continue;
+			}
+
+			switch (synthetic.Type)
+			{
+				case Event::Type::WindowResize:
+				case Event::Type::MouseMoved:
+				case Event::Type::MouseScrolled:
+				case Event::Type::MouseRawInput:
+					iss >> synthetic.X >> synthetic.Y;
+					break;
+				case Event::Type::KeyPressed:
+					iss >> synthetic.Code >> synthetic.X;
+					break;
+				case Event::Type::WindowClosed:
+					break;
+				default:
+					iss >> synthetic.Code;
+					break;
+			}
+			m_Script.emplace_back(synthetic);
+		}
+
+		std::stable_sort(m_Script.begin(), m_Script.end(), [](const SyntheticEvent& a, const SyntheticEvent& b)
+		{
+			return a.Frame < b.Frame;
+		});
+	}
+
+	void HeadlessWindow::EmitEvent(const SyntheticEvent& synthetic)
+	{
+		switch (synthetic.Type)
+		{
+			case Event::Type::WindowResize:
+			{
+				Resize((int32)synthetic.X, (int32)synthetic.Y);
+				break;
+			}
+			case Event::Type::WindowFocus:
+			{
+				PushEvent<WindowFocusEvent>(synthetic.Code != 0);
+				break;
+			}
+			case Event::Type::WindowClosed:
+			{
+				PushEvent<WindowClosedEvent>();
+				break;
+			}
+			case Event::Type::KeyPressed:
+			{
+				if (synthetic.Code >= 0 && synthetic.Code < (int32)m_KeyStates.size())
+					m_KeyStates.set(synthetic.Code);
+
+				PushEvent<KeyPressedEvent>(synthetic.Code, (int32)synthetic.X);
+				break;
+			}
+			case Event::Type::KeyReleased:
+			{
+				if (synthetic.Code >= 0 && synthetic.Code < (int32)m_KeyStates.size())
+					m_KeyStates.reset(synthetic.Code);
+
+				PushEvent<KeyReleasedEvent>(synthetic.Code);
+				break;
+			}
+			case Event::Type::KeyTyped:
+			{
+				PushEvent<KeyTypedEvent>(synthetic.Code);
+				break;
+			}
+			case Event::Type::MouseButtonPressed:
+			{
+				if (synthetic.Code >= 0 && synthetic.Code < (int32)m_MouseStates.size())
+					m_MouseStates.set(synthetic.Code);
+
+				PushEvent<MouseButtonPressedEvent>(synthetic.Code);
+				break;
+			}
+			case Event::Type::MouseButtonReleased:
+			{
+				if (synthetic.Code >= 0 && synthetic.Code < (int32)m_MouseStates.size())
+					m_MouseStates.reset(synthetic.Code);
+
+				PushEvent<MouseButtonReleasedEvent>(synthetic.Code);
+				break;
+			}
+			case Event::Type::MouseMoved:
+			{
+				int32 x = (int32)std::floor(synthetic.X);
+				int32 y = (int32)std::floor(synthetic.Y);
+				SetMousePosition(x, y);
+
+				PushEvent<MouseMovedEvent>(x, y);
+				break;
+			}
+			case Event::Type::MouseScrolled:
+			{
+				PushEvent<MouseScrolledEvent>(synthetic.X, synthetic.Y);
+				break;
+			}
+			case Event::Type::MouseRawInput:
+			{
+				AddRawMouseSample(synthetic.X, synthetic.Y);
+				break;
+			}
+			default:
+			{
+				LOG_WARN("Headless window cannot synthesize event type {}", (int32)synthetic.Type);
+				break;
+			}
+		}
+	}
+
+	void HeadlessWindow::Resize(int32 width, int32 height)
+	{
+		const WindowGeometry& current = m_Geometry.Peek();
+		if (width == current.Width && height == current.Height)
+			return;
+
+		m_Geometry.Update([width, height](WindowGeometry& geometry)
+		{
+			geometry.Width = geometry.FramebufferWidth = width;
+			geometry.Height = geometry.FramebufferHeight = height;
+		});
+
+		PushEvent<WindowResizeEvent>(width, height);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include "Core/Window.h"
+#include <bitset>
+
+namespace DT
+{
+	/* window without a display: every ProcessEvents() is one frame, input comes from a script/generator */
+	class HeadlessWindow : public Window
+	{
+	public:
+		HeadlessWindow(const WindowSpecification& specification);
+		virtual ~HeadlessWindow() override = default;
+
+		virtual void SetEventQueue(EventQueue* queue) override;
+		virtual const WindowSpecification& GetSpecification() const { return m_Specification; };
+
+		virtual void ProcessEvents() override;
+		virtual void WaitEvents(float timeoutSeconds) override { ProcessEvents(); }
+		virtual void Maximize() override;
+		virtual void CenterWindow() override {}
+		virtual void ToFullscreen() override;
+		virtual void ToWindowed() override;
+		virtual std::string GetClipboardString() const override { return m_Clipboard; }
+
+		virtual void SetFixedAspectRatio(int32 numerator, int32 denominator) override {}
+		virtual void SetMousePosition(int32 x, int32 y) override;
+		virtual void SetOpacity(float opacityValue) override {}
+		virtual void SetTitle(const std::string& title) override {}
+		virtual void SetDecorated(bool isDecorated) override {}
+		virtual void SetResizable(bool isResizable) override {}
+		virtual void SetSize(int32 width, int32 height) override;
+		virtual void SetPosition(int32 x, int32 y) override;
+		virtual void SetSizeLimits(int32 minWidth, int32 minHeight, int32 maxWidth, int32 maxHeight) override {}
+		virtual void SetIcon(const std::filesystem::path& iconPath) override {}
+
+		virtual bool KeyIsPressed(KeyCode key) const override;
+		virtual bool MouseIsPressed(MouseCode button) const override;
+
+		virtual void SetRawMouseInput(bool enabled) override { m_RawMouseInput = enabled; }
+
+		uint64 GetFrameIndex() const { return m_FrameIndex; }
+	private:
+		void LoadScript(const std::filesystem::path& scriptPath);
+		void EmitEvent(const SyntheticEvent& synthetic);
+		void Resize(int32 width, int32 height);
+
+		template<typename T, typename... Args>
+		void PushEvent(Args&&... args)
+		{
+			if (m_Queue)
+				m_Queue->Push<T>(std::forward<Args>(args)...);
+		}
+	private:
+		inline static constexpr Extent s_DisplayResolution = { 1920, 1080 };
+
+		WindowSpecification m_Specification;
+		EventQueue* m_Queue = nullptr;
+
+		std::vector<SyntheticEvent> m_Script;
+		std::vector<SyntheticEvent> m_Generated;
+		size_t m_ScriptCursor = 0u;
+		uint64 m_FrameIndex = 0u;
+
+		int32 m_WindowedWidth = 0;
+		int32 m_WindowedHeight = 0;
+		std::string m_Clipboard;
+
+		std::bitset<512> m_KeyStates;
+		std::bitset<8> m_MouseStates;
+	};
+}
\ No newline at end of file
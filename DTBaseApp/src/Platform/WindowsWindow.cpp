@@ -1,17 +1,11 @@
 #include "WindowsWindow.h"
 #include <GLFW/glfw3.h>
 #include "Core/Core.h"
-#include <stb_image.h>
 
 namespace DT
 {
 	static bool s_GLFWInitialized = false;
-	static uint32 s_ActiveWindowsCount = 0u;
-
-	Window* Window::Create(const WindowSpecification& specification)
-	{
-		return new WindowsWindow(specification);
-	}
+	static std::vector<WindowsWindow*> s_ActiveWindows;
 
 	WindowsWindow::WindowsWindow(const WindowSpecification& specification)
 		: m_Specification(specification)
@@ -22,15 +16,23 @@ namespace DT
 			ASSERT(result);
 			LOG_TRACE("GLFW Version {}", glfwGetVersionString());
 
+			// monitor connected/disconnected: the mode of the primary monitor may have changed
+			glfwSetMonitorCallback([](GLFWmonitor* monitor, int event)
+			{
+				for (WindowsWindow* window : s_ActiveWindows)
+					window->RefreshDisplayMode();
+			});
+
 			s_GLFWInitialized = true;
 		}
 
 		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 		m_GLFWWindow = glfwCreateWindow(m_Specification.Width, m_Specification.Height, m_Specification.Title.c_str(), nullptr, nullptr);
-		s_ActiveWindowsCount++;
+		s_ActiveWindows.push_back(this);
 
-		m_WindowData.Width = m_Specification.Width;
-		m_WindowData.Height = m_Specification.Height;
+		m_WindowData.Geometry = &m_Geometry;
+		m_WindowData.Owner = this;
+		RefreshGeometry();
 
 		InstallGLFWCallbacks();
 
@@ -49,33 +51,56 @@ namespace DT
 
 	WindowsWindow::~WindowsWindow()
 	{
-		s_ActiveWindowsCount--;
-		if (s_ActiveWindowsCount == 0u)
+		std::erase(s_ActiveWindows, this);
+		if (s_ActiveWindows.empty())
 			glfwTerminate();
 	}
 
-	void WindowsWindow::SetEventCallBack(const EventCallbackFn& callback) 
+	void WindowsWindow::SetEventQueue(EventQueue* queue) 
 	{ 
-		m_WindowData.Callback = callback; 
+		m_WindowData.Queue = queue; 
 	}
 
 	void WindowsWindow::ProcessEvents()
 	{
+		BeginRawMouseFrame();
 		glfwPollEvents();
+		PushRawMouseEvent();
+		ApplyPendingIcon();
 	}
 
-	int32 WindowsWindow::GetWidth() const
+	void WindowsWindow::WaitEvents(float timeoutSeconds)
 	{
-		int width;
-		glfwGetWindowSize(m_GLFWWindow, &width, nullptr);
-		return width;
+		BeginRawMouseFrame();
+		glfwWaitEventsTimeout((double)timeoutSeconds);
+		PushRawMouseEvent();
+		ApplyPendingIcon();
 	}
 
-	int32 WindowsWindow::GetHeight() const
+	void WindowsWindow::PushRawMouseEvent()
 	{
-		int height;
-		glfwGetWindowSize(m_GLFWWindow, nullptr, &height);
-		return height;
+		if (m_RawMouseSamples.empty())
+			return;
+
+		auto [deltaX, deltaY] = GetRawMouseDelta();
+		m_WindowData.PushEvent<MouseRawInputEvent>(deltaX, deltaY);
+	}
+
+	void WindowsWindow::SetRawMouseInput(bool enabled)
+	{
+		if (enabled == m_RawMouseInput)
+			return;
+
+		glfwSetInputMode(m_GLFWWindow, GLFW_CURSOR, enabled ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+		if (glfwRawMouseMotionSupported())
+			glfwSetInputMode(m_GLFWWindow, GLFW_RAW_MOUSE_MOTION, enabled ? GLFW_TRUE : GLFW_FALSE);
+		else if (enabled)
+			LOG_WARN("Raw mouse motion is not supported, falling back to the accelerated cursor deltas");
+
+		glfwGetCursorPos(m_GLFWWindow, &m_WindowData.LastRawX, &m_WindowData.LastRawY);
+		m_WindowData.RawMouseInput = enabled;
+		m_RawMouseInput = enabled;
+		m_RawMouseSamples.reserve(256u);
 	}
 
 	void WindowsWindow::Maximize()
@@ -86,11 +111,15 @@ namespace DT
 	void WindowsWindow::ToFullscreen()
 	{
 		glfwSetWindowMonitor(m_GLFWWindow, glfwGetPrimaryMonitor(), 0, 0, 1280, 720, GLFW_DONT_CARE);
+		m_Geometry.Update([](WindowGeometry& geometry) { geometry.Fullscreen = true; });
+		RefreshDisplayMode();
 	}
 
 	void WindowsWindow::ToWindowed()
 	{
 		glfwSetWindowMonitor(m_GLFWWindow, nullptr, 0, 0, 1280, 720, GLFW_DONT_CARE);
+		m_Geometry.Update([](WindowGeometry& geometry) { geometry.Fullscreen = false; });
+		RefreshDisplayMode();
 	}
 
 	void WindowsWindow::SetFixedAspectRatio(int32 numerator, int32 denominator)
@@ -98,23 +127,14 @@ namespace DT
 		glfwSetWindowAspectRatio(m_GLFWWindow, numerator, denominator);
 	}
 
-	int32 WindowsWindow::GetMouseX() const
-	{
-		double xpos;
-		glfwGetCursorPos(m_GLFWWindow, &xpos, nullptr);
-		return (int32)std::floor(xpos);
-	}
-	
-	int32 WindowsWindow::GetMouseY() const
-	{
-		double ypos;
-		glfwGetCursorPos(m_GLFWWindow, nullptr, &ypos);
-		return (int32)std::floor(ypos);
-	}
-
 	void WindowsWindow::SetMousePosition(int32 x, int32 y)
 	{
 		glfwSetCursorPos(m_GLFWWindow, (double)x, (double)y);
+		m_Geometry.Update([x, y](WindowGeometry& geometry)
+		{
+			geometry.MouseX = x;
+			geometry.MouseY = y;
+		});
 	}
 
 	std::string WindowsWindow::GetClipboardString() const
@@ -154,13 +174,10 @@ namespace DT
 
 	void WindowsWindow::CenterWindow()
 	{
-		const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
-
-		int windowWidth, windowHeight;
-		glfwGetWindowSize(m_GLFWWindow, &windowWidth, &windowHeight);
+		const WindowGeometry& geometry = m_Geometry.Peek();
 
-		int32 x = (videoMode->width - windowWidth) / 2;
-		int32 y = (videoMode->height - windowHeight) / 2;
+		int32 x = (geometry.DisplayResolution.Width - geometry.Width) / 2;
+		int32 y = (geometry.DisplayResolution.Height - geometry.Height) / 2;
 		glfwSetWindowPos(m_GLFWWindow, x, y);
 	}
 
@@ -174,18 +191,56 @@ namespace DT
 		if (!std::filesystem::exists(iconPath))
 			return;
 
-		GLFWimage icon;
-		int width, height, channels;
-		icon.pixels = stbi_load(iconPath.string().c_str(), &width, &height, &channels, 4);
-		icon.width = width;
-		icon.height = height;
-		glfwSetWindowIcon(m_GLFWWindow, 1, &icon);
+		m_PendingIcon = ImageLoader::Load(iconPath);
+		ApplyPendingIcon();
+	}
+
+	void WindowsWindow::ApplyPendingIcon()
+	{
+		if (!m_PendingIcon.IsDone())
+			return;
+
+		/* GLFW copies the pixels, the image can go back to the cache */
+		if (const Image* image = m_PendingIcon.Get())
+		{
+			GLFWimage icon;
+			icon.width = (int)image->GetWidth();
+			icon.height = (int)image->GetHeight();
+			icon.pixels = const_cast<unsigned char*>(image->GetPixels());
+			glfwSetWindowIcon(m_GLFWWindow, 1, &icon);
+		}
+		m_PendingIcon = {};
 	}
 
-	Extent WindowsWindow::GetDisplayResolution() const
+	void WindowsWindow::RefreshGeometry()
+	{
+		WindowGeometry geometry;
+		glfwGetWindowSize(m_GLFWWindow, &geometry.Width, &geometry.Height);
+		glfwGetFramebufferSize(m_GLFWWindow, &geometry.FramebufferWidth, &geometry.FramebufferHeight);
+		glfwGetWindowPos(m_GLFWWindow, &geometry.PositionX, &geometry.PositionY);
+		glfwGetWindowContentScale(m_GLFWWindow, &geometry.ContentScaleX, &geometry.ContentScaleY);
+
+		double mouseX, mouseY;
+		glfwGetCursorPos(m_GLFWWindow, &mouseX, &mouseY);
+		geometry.MouseX = (int32)std::floor(mouseX);
+		geometry.MouseY = (int32)std::floor(mouseY);
+		geometry.Fullscreen = glfwGetWindowMonitor(m_GLFWWindow) != nullptr;
+
+		m_Geometry.Store(geometry);
+		RefreshDisplayMode();
+	}
+
+	void WindowsWindow::RefreshDisplayMode()
 	{
 		const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
-		return { videoMode->width,videoMode->height };
+		if (videoMode == nullptr)
+			return;
+
+		m_Geometry.Update([videoMode](WindowGeometry& geometry)
+		{
+			geometry.DisplayResolution = { videoMode->width, videoMode->height };
+			geometry.RefreshRate = videoMode->refreshRate;
+		});
 	}
 
 	void WindowsWindow::EnumerateDisplayModes()
@@ -212,11 +267,46 @@ namespace DT
 		glfwSetWindowSizeCallback(m_GLFWWindow, [](GLFWwindow* window, int width, int height)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
-			data.Width = width;
-			data.Height = height;
+			data.Geometry->Update([width, height](WindowGeometry& geometry)
+			{
+				geometry.Width = width;
+				geometry.Height = height;
+			});
+
+			data.PushEvent<WindowResizeEvent>(width, height);
+		});
+
+		// framebuffer resize callback
+		glfwSetFramebufferSizeCallback(m_GLFWWindow, [](GLFWwindow* window, int width, int height)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+			data.Geometry->Update([width, height](WindowGeometry& geometry)
+			{
+				geometry.FramebufferWidth = width;
+				geometry.FramebufferHeight = height;
+			});
+		});
+
+		// window move callback
+		glfwSetWindowPosCallback(m_GLFWWindow, [](GLFWwindow* window, int x, int y)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+			data.Geometry->Update([x, y](WindowGeometry& geometry)
+			{
+				geometry.PositionX = x;
+				geometry.PositionY = y;
+			});
+		});
 
-			WindowResizeEvent e(width, height);
-			data.Callback(e);
+		// dpi change callback
+		glfwSetWindowContentScaleCallback(m_GLFWWindow, [](GLFWwindow* window, float scaleX, float scaleY)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+			data.Geometry->Update([scaleX, scaleY](WindowGeometry& geometry)
+			{
+				geometry.ContentScaleX = scaleX;
+				geometry.ContentScaleY = scaleY;
+			});
 		});
 
 		// window close callback
@@ -224,8 +314,7 @@ namespace DT
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			WindowClosedEvent e{};
-			data.Callback(e);
+			data.PushEvent<WindowClosedEvent>();
 		});
 
 		// window focus callback
@@ -233,8 +322,7 @@ namespace DT
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			WindowFocusEvent e((bool)focused);
-			data.Callback(e);
+			data.PushEvent<WindowFocusEvent>((bool)focused);
 		});
 
 		// keyboard callback
@@ -246,20 +334,17 @@ namespace DT
 			{
 				case GLFW_PRESS: 
 				{
-					KeyPressedEvent e(key, 0);
-					data.Callback(e);
+					data.PushEvent<KeyPressedEvent>(key, 0);
 					break;
 				}
 				case GLFW_RELEASE:
 				{
-					KeyReleasedEvent e(key);
-					data.Callback(e);
+					data.PushEvent<KeyReleasedEvent>(key);
 					break;
 				}
 				case GLFW_REPEAT:
 				{
-					KeyPressedEvent e(key, 1);
-					data.Callback(e);
+					data.PushEvent<KeyPressedEvent>(key, 1);
 					break;
 				}
 			}
@@ -270,8 +355,7 @@ namespace DT
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			KeyTypedEvent e(key);
-			data.Callback(e);
+			data.PushEvent<KeyTypedEvent>(key);
 		});
 
 		// mouse click callback
@@ -283,14 +367,12 @@ namespace DT
 			{
 				case GLFW_PRESS: 
 				{
-					MouseButtonPressedEvent e(button);
-					data.Callback(e);
+					data.PushEvent<MouseButtonPressedEvent>(button);
 					break;
 				}
 				case GLFW_RELEASE:
 				{
-					MouseButtonReleasedEvent e(button);
-					data.Callback(e);
+					data.PushEvent<MouseButtonReleasedEvent>(button);
 					break;
 				}
 			}
@@ -301,17 +383,29 @@ namespace DT
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 			
-			MouseScrolledEvent e((float)offsetX, (float)offsetY);
-			data.Callback(e);
+			data.PushEvent<MouseScrolledEvent>((float)offsetX, (float)offsetY);
 		});
 
 		// mouse cursor move callback
 		glfwSetCursorPosCallback(m_GLFWWindow, [](GLFWwindow* window, double posX, double posY)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
-		
-			MouseMovedEvent e((int32)std::floor(posX), (int32)std::floor(posY));
-			data.Callback(e);
+			if (data.RawMouseInput)
+			{
+				data.Owner->AddRawMouseSample(float(posX - data.LastRawX), float(posY - data.LastRawY));
+				data.LastRawX = posX;
+				data.LastRawY = posY;
+			}
+
+			int32 x = (int32)std::floor(posX);
+			int32 y = (int32)std::floor(posY);
+			data.Geometry->Update([x, y](WindowGeometry& geometry)
+			{
+				geometry.MouseX = x;
+				geometry.MouseY = y;
+			});
+
+			data.PushEvent<MouseMovedEvent>(x, y);
 		});
 	}
 
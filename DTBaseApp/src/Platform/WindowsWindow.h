@@ -1,5 +1,6 @@
 #pragma once
 #include "Core/Window.h"
+#include "Image/ImageLoader.h"
 
 struct GLFWwindow;
 
@@ -11,20 +12,16 @@ namespace DT
 		WindowsWindow(const WindowSpecification& specification);
 		virtual ~WindowsWindow() override;
 
-		virtual void SetEventCallBack(const EventCallbackFn& callback) override;
+		virtual void SetEventQueue(EventQueue* queue) override;
 		virtual const WindowSpecification& GetSpecification() const { return m_Specification; };
 
 		virtual void ProcessEvents() override;
+		virtual void WaitEvents(float timeoutSeconds) override;
 		virtual void Maximize() override;
 		virtual void CenterWindow() override;
 		virtual void ToFullscreen() override;
 		virtual void ToWindowed() override;
-		virtual int32 GetWidth() const override;
-		virtual int32 GetHeight() const override;
-		virtual int32 GetMouseX() const override;
-		virtual int32 GetMouseY() const override;
 		virtual std::string GetClipboardString() const override;
-		virtual Extent GetDisplayResolution() const override;
 
 		virtual void SetFixedAspectRatio(int32 numerator, int32 denominator) override;
 		virtual void SetMousePosition(int32 x, int32 y) override;
@@ -37,21 +34,41 @@ namespace DT
 		virtual void SetSizeLimits(int32 minWidth, int32 minHeight, int32 maxWidth, int32 maxHeight) override;
 		virtual void SetIcon(const std::filesystem::path& iconPath) override;
 
-		bool KeyIsPressed(KeyCode key) const;
-		bool MouseIsPressed(MouseCode button) const;
+		virtual bool KeyIsPressed(KeyCode key) const override;
+		virtual bool MouseIsPressed(MouseCode button) const override;
+
+		virtual void SetRawMouseInput(bool enabled) override;
 	private:
 		void EnumerateDisplayModes();
 		void InstallGLFWCallbacks();
+
+		/* queries everything once, the callbacks keep it current afterwards */
+		void RefreshGeometry();
+		void RefreshDisplayMode();
+		void PushRawMouseEvent();
+		void ApplyPendingIcon();
 	private:
 		struct WindowData
 		{
-			int32 Width = 0;
-			int32 Height = 0;
+			SeqLock<WindowGeometry>* Geometry = nullptr;
+			EventQueue* Queue = nullptr;
+			WindowsWindow* Owner = nullptr;
+
+			/* in raw mode the cursor position is virtual and unbounded, samples are its differences */
+			bool RawMouseInput = false;
+			double LastRawX = 0.0;
+			double LastRawY = 0.0;
 
-			EventCallbackFn Callback;
+			template<typename T, typename... Args>
+			void PushEvent(Args&&... args)
+			{
+				if (Queue)
+					Queue->Push<T>(std::forward<Args>(args)...);
+			}
 		};
 		WindowData m_WindowData;
 		GLFWwindow* m_GLFWWindow;
+		ImageHandle m_PendingIcon; // decoded off the main thread, applied by ProcessEvents once ready
 
 		WindowSpecification m_Specification;
 	};
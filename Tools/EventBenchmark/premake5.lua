@@ -0,0 +1,43 @@
+project "EventBenchmark"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "off"
+
+	targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/bin-intermediate/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"src/**.h",
+		"src/**.cpp"
+	}
+
+	includedirs
+	{
+		"%{wks.location}/DTBaseApp/src",
+		"%{IncludeDir.spdlog}"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+		defines
+		{
+			"DT_PLATFORM_WINDOWS",
+			"_SILENCE_ALL_CXX23_DEPRECATION_WARNINGS"
+		}
+
+	filter "system:linux"
+		defines
+		{
+			"DT_PLATFORM_LINUX"
+		}
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
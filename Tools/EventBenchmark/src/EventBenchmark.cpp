@@ -0,0 +1,151 @@
+#include "Core/EventDispatchTable.h"
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+/*
+	usage: EventBenchmark [count]
+	dispatches a synthetic stream of count events (default 1M, random types, some of them unhandled) to a layer
+	handling four event types, once through Event::Dispatcher and once through EventDispatchTable,
+	and checks that both reach the same handlers
+*/
+namespace
+{
+	using namespace DT;
+
+	constexpr uint32 Repetitions = 5u;
+
+	class BenchmarkLayer
+	{
+	public:
+		void OnEventDispatcher(Event& event)
+		{
+			Event::Dispatcher dispatcher(event);
+			dispatcher.Dispatch<KeyPressedEvent>([this](KeyPressedEvent& key) { return OnKeyPressed(key); });
+			dispatcher.Dispatch<MouseMovedEvent>([this](MouseMovedEvent& mouse) { return OnMouseMoved(mouse); });
+			dispatcher.Dispatch<MouseScrolledEvent>([this](MouseScrolledEvent& scroll) { return OnMouseScrolled(scroll); });
+			dispatcher.Dispatch<WindowResizeEvent>([this](WindowResizeEvent& resize) { return OnWindowResize(resize); });
+		}
+
+		void OnEventTable(Event& event)
+		{
+			EventHandlers::Dispatch(*this, event);
+		}
+
+		uint64 GetChecksum() const { return m_Checksum; }
+		void ResetChecksum() { m_Checksum = 0u; }
+	private:
+		bool OnKeyPressed(KeyPressedEvent& key)
+		{
+			m_Checksum += uint64(key.GetKeyCode());
+			return false;
+		}
+
+		bool OnMouseMoved(MouseMovedEvent& mouse)
+		{
+			m_Checksum += uint64(mouse.GetX()) * 3u + uint64(mouse.GetY());
+			return false;
+		}
+
+		bool OnMouseScrolled(MouseScrolledEvent& scroll)
+		{
+			m_Checksum += uint64(scroll.GetDeltaY() * 8.0f);
+			return false;
+		}
+
+		bool OnWindowResize(WindowResizeEvent& resize)
+		{
+			m_Checksum += uint64(resize.GetWidth()) * uint64(resize.GetHeight());
+			return false;
+		}
+	private:
+		using EventHandlers = EventDispatchTable<
+			&BenchmarkLayer::OnKeyPressed,
+			&BenchmarkLayer::OnMouseMoved,
+			&BenchmarkLayer::OnMouseScrolled,
+			&BenchmarkLayer::OnWindowResize>;
+
+		uint64 m_Checksum = 0u;
+	};
+
+	/* mostly mouse motion like a real input stream, plus event types the layer does not handle */
+	std::vector<std::unique_ptr<Event>> MakeEventStream(uint32 count)
+	{
+		std::vector<std::unique_ptr<Event>> events;
+		events.reserve(count);
+
+		std::mt19937 random(1234u);
+		for (uint32 i = 0u; i < count; i++)
+		{
+			uint32 value = random();
+			switch (value % 10u)
+			{
+				case 0u: case 1u: case 2u: case 3u:
+					events.push_back(std::make_unique<MouseMovedEvent>(int32(value >> 8u & 1023u), int32(value >> 18u & 1023u))); break;
+				case 4u: events.push_back(std::make_unique<KeyPressedEvent>(int32(value >> 8u & 255u), 0)); break;
+				case 5u: events.push_back(std::make_unique<KeyReleasedEvent>(int32(value >> 8u & 255u))); break;
+				case 6u: events.push_back(std::make_unique<MouseScrolledEvent>(0.0f, float(value >> 8u & 7u))); break;
+				case 7u: events.push_back(std::make_unique<WindowResizeEvent>(int32(value >> 8u & 2047u), int32(value >> 20u & 2047u))); break;
+				case 8u: events.push_back(std::make_unique<MouseButtonPressedEvent>(int32(value >> 8u & 7u))); break;
+				default: events.push_back(std::make_unique<AppTickEvent>()); break;
+			}
+		}
+		return events;
+	}
+
+	/* best of a few runs, in milliseconds */
+	double Measure(const std::function<void()>& work)
+	{
+		uint64 best = ~0ull;
+		for (uint32 i = 0u; i < Repetitions; i++)
+		{
+			Timer timer;
+			work();
+			best = std::min(best, timer.ElapsedNanoseconds());
+		}
+		return double(best) * 1e-6;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint32 count = argc > 1 ? uint32(std::atoi(argv[1])) : 1000000u;
+	if (count == 0u)
+	{
+		std::fprintf(stderr, "count must be at least 1\n");
+		return 1;
+	}
+
+	std::vector<std::unique_ptr<Event>> events = MakeEventStream(count);
+	BenchmarkLayer layer;
+
+	double dispatcherMilliseconds = Measure([&]
+	{
+		layer.ResetChecksum();
+		for (std::unique_ptr<Event>& event : events)
+			layer.OnEventDispatcher(*event);
+	});
+	uint64 dispatcherChecksum = layer.GetChecksum();
+
+	double tableMilliseconds = Measure([&]
+	{
+		layer.ResetChecksum();
+		for (std::unique_ptr<Event>& event : events)
+			layer.OnEventTable(*event);
+	});
+	uint64 tableChecksum = layer.GetChecksum();
+
+	std::printf("%u events, 4 handled types, best of %u\n\n", count, Repetitions);
+	std::printf("%-20s %10s %10s\n", "method", "ms", "ns/event");
+	std::printf("%-20s %10.2f %10.2f\n", "Event::Dispatcher", dispatcherMilliseconds, dispatcherMilliseconds * 1e6 / count);
+	std::printf("%-20s %10.2f %10.2f\n", "EventDispatchTable", tableMilliseconds, tableMilliseconds * 1e6 / count);
+
+	if (dispatcherChecksum != tableChecksum)
+	{
+		std::printf("\nhandlers disagree: %llu vs %llu\n", (unsigned long long)dispatcherChecksum, (unsigned long long)tableChecksum);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,60 @@
+project "ImageBenchmark"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "off"
+
+	targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/bin-intermediate/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"src/**.h",
+		"src/**.cpp",
+		"%{wks.location}/DTBaseApp/src/Image/Image.h",
+		"%{wks.location}/DTBaseApp/src/Image/Image.cpp",
+		"%{wks.location}/DTBaseApp/src/Image/ImageKernels.h",
+		"%{wks.location}/DTBaseApp/src/Image/ImageKernels.cpp",
+		"%{wks.location}/DTBaseApp/src/Image/MipChain.h",
+		"%{wks.location}/DTBaseApp/src/Image/MipChain.cpp",
+		"%{wks.location}/DTBaseApp/src/Core/JobSystem.h",
+		"%{wks.location}/DTBaseApp/src/Core/JobSystem.cpp",
+		"%{wks.location}/DTBaseApp/src/Core/MappedFile.h",
+		"%{wks.location}/DTBaseApp/src/Core/MappedFile.cpp",
+		"%{wks.location}/vendor/stb/stb_build.cpp"
+	}
+
+	includedirs
+	{
+		"%{wks.location}/DTBaseApp/src",
+		"%{IncludeDir.spdlog}",
+		"%{IncludeDir.stb}"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+		defines
+		{
+			"DT_PLATFORM_WINDOWS",
+			"_SILENCE_ALL_CXX23_DEPRECATION_WARNINGS"
+		}
+
+	filter "system:linux"
+		defines
+		{
+			"DT_PLATFORM_LINUX"
+		}
+
+		links
+		{
+			"pthread"
+		}
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "Image/MipChain.h"
+#include "Core/JobSystem.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+/*
+	usage: ImageBenchmark [size] [workers]
+	times every ImageKernels level and the stb_image_resize reference on a synthetic size x size image (default 4096),
+	checks that all levels agree with the scalar kernels bit for bit and reports the largest difference to stb.
+	Then builds the full mip chain level by level and tiled with MipChain, with and without job system workers
+	(default one per hardware thread)
+*/
+namespace
+{
+	using namespace DT;
+
+	constexpr uint32 Repetitions = 5u;
+
+	/* gradients for the filters to blend, noise so nothing compresses into a trivial pattern, varying alpha */
+	std::vector<uint8> MakeTestImage(uint32 size)
+	{
+		std::vector<uint8> pixels(uint64(size) * size * 4u);
+		std::mt19937 random(1234u);
+		for (uint32 y = 0u; y < size; y++)
+		{
+			for (uint32 x = 0u; x < size; x++)
+			{
+				uint8* pixel = &pixels[(uint64(y) * size + x) * 4u];
+				uint32 noise = random();
+				pixel[0] = uint8(x * 255u / size);
+				pixel[1] = uint8(y * 255u / size);
+				pixel[2] = uint8(noise);
+				pixel[3] = uint8(((x ^ y) & 64u) ? 255u : noise >> 8u);
+			}
+		}
+		return pixels;
+	}
+
+	/* best of a few runs, in milliseconds */
+	double Measure(const std::function<void()>& work)
+	{
+		uint64 best = ~0ull;
+		for (uint32 i = 0u; i < Repetitions; i++)
+		{
+			Timer timer;
+			work();
+			best = std::min(best, timer.ElapsedNanoseconds());
+		}
+		return double(best) * 1e-6;
+	}
+
+	uint32 MaxDifference(const std::vector<uint8>& a, const std::vector<uint8>& b)
+	{
+		uint32 result = 0u;
+		for (uint64 i = 0u; i < a.size(); i++)
+			result = std::max(result, uint32(std::abs(int32(a[i]) - int32(b[i]))));
+		return result;
+	}
+
+	struct Case
+	{
+		const char* Name;
+		uint64 Pixels; // source pixels touched, for the throughput column
+		std::function<void(std::vector<uint8>& output)> Run;
+		std::function<void(std::vector<uint8>& output)> Reference;
+	};
+}
+
+int main(int argc, char** argv)
+{
+	uint32 size = argc > 1 ? uint32(std::atoi(argv[1])) : 4096u;
+	uint32 workers = argc > 2 ? uint32(std::atoi(argv[2])) : 0u;
+	if (size < 16u)
+	{
+		std::fprintf(stderr, "size must be at least 16\n");
+		return 1;
+	}
+
+	std::vector<uint8> source = MakeTestImage(size);
+	uint64 pixelCount = uint64(size) * size;
+	uint64 pitch = uint64(size) * 4u;
+	std::vector<float> linear(pixelCount * 4u);
+
+	auto resize = [&](uint32 divisor, ImageColorSpace colorSpace, bool reference)
+	{
+		return [&source, size, pitch, divisor, colorSpace, reference](std::vector<uint8>& output)
+		{
+			uint32 target = size / divisor;
+			output.resize(uint64(target) * target * 4u);
+			if (reference)
+				ImageKernels::ResizeReference(source.data(), size, size, pitch, output.data(), target, target, uint64(target) * 4u, colorSpace);
+			else
+				ImageKernels::Resize(source.data(), size, size, pitch, output.data(), target, target, uint64(target) * 4u, colorSpace);
+		};
+	};
+
+	std::vector<Case> cases =
+	{
+		{ "Resize 1/2 sRGB",   pixelCount, resize(2u, ImageColorSpace::Srgb, false),   resize(2u, ImageColorSpace::Srgb, true) },
+		{ "Resize 1/4 sRGB",   pixelCount, resize(4u, ImageColorSpace::Srgb, false),   resize(4u, ImageColorSpace::Srgb, true) },
+		{ "Resize 1/2 linear", pixelCount, resize(2u, ImageColorSpace::Linear, false), resize(2u, ImageColorSpace::Linear, true) },
+		{ "sRGB to linear", pixelCount, [&](std::vector<uint8>& output)
+			{
+				output.resize(linear.size() * sizeof(float));
+				ImageKernels::SrgbToLinear(source.data(), reinterpret_cast<float*>(output.data()), pixelCount);
+			}, nullptr },
+		{ "Linear to sRGB", pixelCount, [&](std::vector<uint8>& output)
+			{
+				output.resize(pixelCount * 4u);
+				ImageKernels::LinearToSrgb(linear.data(), output.data(), pixelCount);
+			}, nullptr },
+		{ "Premultiply alpha", pixelCount, [&](std::vector<uint8>& output)
+			{
+				output = source;
+				ImageKernels::PremultiplyAlpha(output.data(), pixelCount);
+			}, nullptr },
+		{ "Swap red/blue", pixelCount, [&](std::vector<uint8>& output)
+			{
+				output.resize(source.size());
+				ImageKernels::SwapRedBlue(source.data(), output.data(), pixelCount);
+			}, nullptr },
+	};
+
+	/* linear to sRGB reads what sRGB to linear wrote */
+	ImageKernels::SrgbToLinear(source.data(), linear.data(), pixelCount);
+
+	SimdLevel supported = ImageKernels::GetSupportedLevel();
+	std::printf("%ux%u RGBA8, best of %u, supported level %s\n\n", size, size, Repetitions, ImageKernels::GetLevelName(supported));
+	std::printf("%-18s %-10s %10s %10s %8s\n", "kernel", "level", "ms", "MP/s", "max diff");
+
+	bool mismatch = false;
+	for (const Case& test : cases)
+	{
+		std::vector<uint8> expected, output;
+		if (test.Reference)
+		{
+			double milliseconds = Measure([&] { test.Reference(output); });
+			std::printf("%-18s %-10s %10.2f %10.1f\n", test.Name, "stb", milliseconds, test.Pixels * 1e-3 / milliseconds);
+			expected = output;
+		}
+
+		std::vector<uint8> scalar;
+		for (uint32 level = 0u; level <= uint32(supported); level++)
+		{
+			ImageKernels::SetLevel(SimdLevel(level));
+			double milliseconds = Measure([&] { test.Run(output); });
+			if (level == 0u)
+				scalar = output;
+
+			/* against stb for resizes, against the scalar kernels for the rest */
+			uint32 difference = MaxDifference(output, expected.empty() ? scalar : expected);
+			bool exact = output == scalar;
+			mismatch |= !exact;
+			std::printf("%-18s %-10s %10.2f %10.1f %8u%s\n", test.Name, ImageKernels::GetLevelName(SimdLevel(level)),
+				milliseconds, test.Pixels * 1e-3 / milliseconds, difference, exact ? "" : "  differs from Scalar");
+		}
+		std::printf("\n");
+	}
+
+	ImageKernels::SetLevel(supported);
+
+	/* the mip chain as a per level pipeline builds it: each level resized from the 8 bit previous one */
+	auto chainByLevel = [&](bool reference)
+	{
+		std::vector<uint8> previous = source, next;
+		for (uint32 width = size; width > 1u; width /= 2u)
+		{
+			uint32 half = width / 2u;
+			next.resize(uint64(half) * half * 4u);
+			if (reference)
+				ImageKernels::ResizeReference(previous.data(), width, width, uint64(width) * 4u, next.data(), half, half, uint64(half) * 4u, ImageColorSpace::Srgb);
+			else
+				ImageKernels::Resize(previous.data(), width, width, uint64(width) * 4u, next.data(), half, half, uint64(half) * 4u, ImageColorSpace::Srgb);
+			std::swap(previous, next);
+		}
+	};
+
+	Image image(size, size);
+	std::memcpy(image.GetPixels(), source.data(), source.size());
+	std::printf("%-18s %-22s %10s\n", "mip chain", "method", "ms");
+	std::printf("%-18s %-22s %10.2f\n", "sRGB, full chain", "stb per level", Measure([&] { chainByLevel(true); }));
+	std::printf("%-18s %-22s %10.2f\n", "sRGB, full chain", "kernels per level", Measure([&] { chainByLevel(false); }));
+	std::printf("%-18s %-22s %10.2f\n", "sRGB, full chain", "MipChain, 0 workers", Measure([&] { MipChain::Generate(image); }));
+
+	JobSystem::Init(workers);
+	std::string tiled = std::format("MipChain, {} workers", JobSystem::GetWorkerCount());
+	std::printf("%-18s %-22s %10.2f\n", "sRGB, full chain", tiled.c_str(), Measure([&] { MipChain::Generate(image); }));
+	JobSystem::Shutdown();
+
+	return mismatch ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+project "LogBenchmark"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "off"
+
+	targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/bin-intermediate/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"src/**.h",
+		"src/**.cpp",
+		"%{wks.location}/DTBaseApp/src/Core/Log.h",
+		"%{wks.location}/DTBaseApp/src/Core/Log.cpp",
+		"%{wks.location}/DTBaseApp/src/Core/AsyncLogger.h",
+		"%{wks.location}/DTBaseApp/src/Core/AsyncLogger.cpp",
+		"%{wks.location}/DTBaseApp/src/Core/Clock.h",
+		"%{wks.location}/DTBaseApp/src/Core/Clock.cpp"
+	}
+
+	includedirs
+	{
+		"%{wks.location}/DTBaseApp/src",
+		"%{IncludeDir.spdlog}"
+	}
+
+	defines
+	{
+		"DT_ENABLE_LOGGING"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+		defines
+		{
+			"DT_PLATFORM_WINDOWS",
+			"_SILENCE_ALL_CXX23_DEPRECATION_WARNINGS"
+		}
+
+	filter "system:linux"
+		defines
+		{
+			"DT_PLATFORM_LINUX"
+		}
+
+		links
+		{
+			"pthread"
+		}
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
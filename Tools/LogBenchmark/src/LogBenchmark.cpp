@@ -0,0 +1,81 @@
+#include "Core/Core.h"
+#include <spdlog/sinks/basic_file_sink.h>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+/*
+	usage: LogBenchmark [count]
+	times every LOG_TRACE call on the calling thread (default 20000 calls with three arguments) in synchronous mode
+	and in asynchronous mode with both overflow policies, and reports the latency percentiles.
+	Messages go to a file in the temporary directory, so the synchronous numbers include the write.
+	With a single hardware thread the flusher preempts the caller, which shows up in the asynchronous max
+*/
+namespace
+{
+	using namespace DT;
+
+	struct Mode
+	{
+		const char* Name;
+		LogMode Mode;
+		LogOverflowPolicy OverflowPolicy;
+	};
+
+	uint64 Percentile(const std::vector<uint64>& sorted, double fraction)
+	{
+		return sorted[std::min(uint64(fraction * double(sorted.size())), uint64(sorted.size() - 1u))];
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint32 count = argc > 1 ? uint32(std::atoi(argv[1])) : 20000u;
+	if (count == 0u)
+	{
+		std::fprintf(stderr, "count must be at least 1\n");
+		return 1;
+	}
+
+	Clock::Init();
+	std::filesystem::path logPath = std::filesystem::temp_directory_path() / "LogBenchmark.log";
+
+	const Mode modes[] =
+	{
+		{ "sync",              LogMode::Synchronous,  LogOverflowPolicy::Block },
+		{ "async/block",       LogMode::Asynchronous, LogOverflowPolicy::Block },
+		{ "async/drop-oldest", LogMode::Asynchronous, LogOverflowPolicy::DropOldest }
+	};
+
+	std::printf("%u LOG_TRACE calls with 3 arguments, queue size %u, %u hardware threads\n\n", count, LogSpecification().QueueSize, std::thread::hardware_concurrency());
+	std::printf("%-18s %10s %10s %10s %10s %10s\n", "mode", "p50 ns", "p99 ns", "p99.9 ns", "max ns", "dropped");
+
+	std::vector<uint64> latencies(count);
+	for (const Mode& mode : modes)
+	{
+		LogSpecification specification;
+		specification.Mode = mode.Mode;
+		specification.OverflowPolicy = mode.OverflowPolicy;
+		specification.Sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(logPath.string(), true);
+		Log::Init(specification);
+
+		for (uint32 i = 0u; i < count; i++)
+		{
+			uint64 start = Clock::Now();
+			LOG_TRACE("frame {} took {:.3f} ms on {}", i, double(i) * 0.001, mode.Name);
+			latencies[i] = Clock::Now() - start;
+		}
+
+		uint64 dropped = Log::GetDroppedMessageCount();
+		Log::Shutdown();
+
+		std::sort(latencies.begin(), latencies.end());
+		std::printf("%-18s %10llu %10llu %10llu %10llu %10llu\n", mode.Name,
+			(unsigned long long)Percentile(latencies, 0.5), (unsigned long long)Percentile(latencies, 0.99),
+			(unsigned long long)Percentile(latencies, 0.999), (unsigned long long)latencies.back(), (unsigned long long)dropped);
+	}
+
+	std::error_code error;
+	std::filesystem::remove(logPath, error);
+	return 0;
+}
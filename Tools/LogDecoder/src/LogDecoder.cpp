@@ -0,0 +1,254 @@
+#include "Core/BinaryLogFormat.h"
+#include "spdlog/fmt/fmt.h"
+#if defined(SPDLOG_FMT_EXTERNAL)
+	#include <fmt/args.h>
+#else
+	#include "spdlog/fmt/bundled/args.h"
+#endif
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+	usage: LogDecoder <file.dtlog> [output.txt]
+	formats the messages written by DT::BinaryLog, one line per message
+*/
+namespace
+{
+	using namespace DT::BinaryLogFormat;
+
+	struct Format
+	{
+		DT::BinaryLogFormat::Level Level;
+		uint32_t Line;
+		std::string File;
+		std::string Text;
+	};
+
+	class Reader
+	{
+	public:
+		Reader(const std::vector<char>& data)
+			: m_Data(data) {}
+
+		bool IsAtEnd() const { return m_Offset >= m_Data.size(); }
+
+		/* end bounds the read further than the end of the data, e.g. to the payload of one message */
+		bool CanRead(size_t size, size_t end = SIZE_MAX) const
+		{
+			end = std::min(end, m_Data.size());
+			return m_Offset <= end && size <= end - m_Offset;
+		}
+
+		template<typename T>
+		bool Read(T& value, size_t end = SIZE_MAX)
+		{
+			if (!CanRead(sizeof(T), end))
+				return false;
+			std::memcpy(&value, m_Data.data() + m_Offset, sizeof(T));
+			m_Offset += sizeof(T);
+			return true;
+		}
+
+		bool ReadString(std::string& string, size_t length, size_t end = SIZE_MAX)
+		{
+			if (!CanRead(length, end))
+				return false;
+			string.assign(m_Data.data() + m_Offset, length);
+			m_Offset += length;
+			return true;
+		}
+
+		size_t GetOffset() const { return m_Offset; }
+		void Seek(size_t offset) { m_Offset = offset; }
+	private:
+		const std::vector<char>& m_Data;
+		size_t m_Offset = 0u;
+	};
+
+	const char* LevelName(Level level)
+	{
+		switch (level)
+		{
+			case Level::Trace:    return "trace";
+			case Level::Debug:    return "debug";
+			case Level::Info:     return "info";
+			case Level::Warn:     return "warning";
+			case Level::Error:    return "error";
+			case Level::Critical: return "critical";
+		}
+		return "unknown";
+	}
+
+	template<typename T>
+	bool PushValue(Reader& reader, size_t payloadEnd, fmt::dynamic_format_arg_store<fmt::format_context>& arguments)
+	{
+		T value;
+		if (!reader.Read(value, payloadEnd))
+			return false;
+		arguments.push_back(value);
+		return true;
+	}
+
+	/* every read stays inside the message payload, a corrupt length cannot reach into the next record */
+	bool PushArgument(Reader& reader, size_t payloadEnd, fmt::dynamic_format_arg_store<fmt::format_context>& arguments)
+	{
+		ArgumentType type;
+		if (!reader.Read(type, payloadEnd))
+			return false;
+
+		switch (type)
+		{
+			case ArgumentType::Bool:   return PushValue<bool>(reader, payloadEnd, arguments);
+			case ArgumentType::Char:   return PushValue<char>(reader, payloadEnd, arguments);
+			case ArgumentType::Int8:   return PushValue<int8_t>(reader, payloadEnd, arguments);
+			case ArgumentType::Int16:  return PushValue<int16_t>(reader, payloadEnd, arguments);
+			case ArgumentType::Int32:  return PushValue<int32_t>(reader, payloadEnd, arguments);
+			case ArgumentType::Int64:  return PushValue<int64_t>(reader, payloadEnd, arguments);
+			case ArgumentType::UInt8:  return PushValue<uint8_t>(reader, payloadEnd, arguments);
+			case ArgumentType::UInt16: return PushValue<uint16_t>(reader, payloadEnd, arguments);
+			case ArgumentType::UInt32: return PushValue<uint32_t>(reader, payloadEnd, arguments);
+			case ArgumentType::UInt64: return PushValue<uint64_t>(reader, payloadEnd, arguments);
+			case ArgumentType::Float:  return PushValue<float>(reader, payloadEnd, arguments);
+			case ArgumentType::Double: return PushValue<double>(reader, payloadEnd, arguments);
+			case ArgumentType::String:
+			{
+				uint32_t length;
+				std::string string;
+				if (!reader.Read(length, payloadEnd) || !reader.ReadString(string, length, payloadEnd))
+					return false;
+				arguments.push_back(string);
+				return true;
+			}
+			case ArgumentType::Pointer:
+			{
+				uint64_t address;
+				if (!reader.Read(address, payloadEnd))
+					return false;
+				arguments.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(address)));
+				return true;
+			}
+		}
+		return false;
+	}
+
+	std::string FormatTimestamp(uint64_t unixNanoseconds)
+	{
+		uint64_t milliseconds = unixNanoseconds / 1000000u;
+		uint64_t secondsOfDay = (milliseconds / 1000u) % 86400u;
+		return fmt::format("{:02}:{:02}:{:02}.{:03}", secondsOfDay / 3600u, (secondsOfDay / 60u) % 60u, secondsOfDay % 60u, milliseconds % 1000u);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << "usage: LogDecoder <file.dtlog> [output.txt]\n";
+		return 1;
+	}
+
+	std::ifstream input(argv[1], std::ios::binary);
+	if (!input)
+	{
+		std::cerr << "could not open " << argv[1] << "\n";
+		return 1;
+	}
+	std::vector<char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+	std::ofstream outputFile;
+	if (argc > 2)
+		outputFile.open(argv[2]);
+	std::ostream& output = outputFile.is_open() ? outputFile : std::cout;
+
+	Reader reader(data);
+	FileHeader header;
+	if (!reader.Read(header) || std::memcmp(header.Magic, Magic, sizeof(Magic)) != 0)
+	{
+		std::cerr << argv[1] << " is not a binary log\n";
+		return 1;
+	}
+	if (header.Version != Version)
+	{
+		std::cerr << argv[1] << " has version " << header.Version << ", expected " << Version << "\n";
+		return 1;
+	}
+
+	std::unordered_map<uint32_t, Format> formats;
+	uint64_t messageCount = 0u;
+
+	while (!reader.IsAtEnd())
+	{
+		RecordType recordType;
+		reader.Read(recordType);
+
+		if (recordType == RecordType::Format)
+		{
+			uint32_t id;
+			uint16_t fileLength, textLength;
+			Format format;
+			if (!reader.Read(id) || !reader.Read(format.Level) || !reader.Read(format.Line) ||
+				!reader.Read(fileLength) || !reader.ReadString(format.File, fileLength) ||
+				!reader.Read(textLength) || !reader.ReadString(format.Text, textLength))
+			{
+				std::cerr << "truncated format record\n";
+				break;
+			}
+			formats[id] = std::move(format);
+		}
+		else if (recordType == RecordType::Message)
+		{
+			uint32_t formatId, threadId, payloadSize;
+			uint64_t timestamp;
+			if (!reader.Read(formatId) || !reader.Read(timestamp) || !reader.Read(threadId) ||
+				!reader.Read(payloadSize) || !reader.CanRead(payloadSize))
+			{
+				std::cerr << "truncated message record\n";
+				break;
+			}
+
+			/* payloadSize lets a bad argument skip just this message */
+			size_t payloadEnd = reader.GetOffset() + payloadSize;
+			auto format = formats.find(formatId);
+			std::string message;
+
+			if (format == formats.end())
+				message = fmt::format("<unknown format {}>", formatId);
+			else
+			{
+				fmt::dynamic_format_arg_store<fmt::format_context> arguments;
+				bool valid = true;
+				while (valid && reader.GetOffset() < payloadEnd)
+					valid = PushArgument(reader, payloadEnd, arguments);
+
+				try
+				{
+					message = valid ? fmt::vformat(format->second.Text, arguments) : "<corrupt arguments>";
+				}
+				catch (const fmt::format_error& error)
+				{
+					message = fmt::format("<{}: {}>", error.what(), format->second.Text);
+				}
+			}
+			reader.Seek(payloadEnd);
+
+			const char* level = format != formats.end() ? LevelName(format->second.Level) : "unknown";
+			output << fmt::format("[{}] [{}] [{}] {}\n", FormatTimestamp(timestamp), level, threadId, message);
+			messageCount++;
+		}
+		else
+		{
+			std::cerr << "unknown record type " << (int)recordType << " at offset " << reader.GetOffset() - 1u << "\n";
+			break;
+		}
+	}
+
+	std::cerr << messageCount << " messages, " << formats.size() << " call sites\n";
+	return 0;
+}
\ No newline at end of file
@@ -15,10 +15,29 @@ workspace "DTBaseApp"
 		"MultiProcessorCompile"
 	}
 
+newoption
+{
+	trigger     = "binary-logging",
+	description = "Log call sites write raw arguments to a binary file, decode it with the LogDecoder tool"
+}
+
+newoption
+{
+	trigger     = "allocation-tracking",
+	description = "Count every operator new/delete, per frame and per profiler zone, and report them at shutdown"
+}
+
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
 include "DTBaseApp"
 
+group "Tools"
+	include "Tools/LogDecoder"
+	include "Tools/ImageBenchmark"
+	include "Tools/EventBenchmark"
+	include "Tools/LogBenchmark"
+group ""
+
 group "Dependencies"
 	include "vendor/glfw"
 group ""
\ No newline at end of file